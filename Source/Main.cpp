@@ -35,18 +35,42 @@ class GuiAppApplication : public juce::JUCEApplication {
         // code..
         juce::ignoreUnused(commandLine);
 
-        // Create application wide file logger
-        logger = std::unique_ptr<juce::FileLogger>(
-            juce::FileLogger::createDefaultAppLogger(
-                getApplicationName(), "log.txt",
-                getApplicationName() + " Logs"));
+        // Create application wide file logger, messages are written to the
+        // file from a background thread
+        logger = std::make_unique<app_services::AsyncFileLogger>(
+            app_services::AsyncFileLogger::getDefaultLogFile(
+                getApplicationName(), "log.txt"),
+            getApplicationName() + " Logs");
         juce::Logger::setCurrentLogger(logger.get());
+#if JUCE_DEBUG
+        logger->setMinimumLevel(app_services::AsyncFileLogger::Level::debug);
+#endif
+
+        auto userAppDataDirectory = juce::File::getSpecialLocation(
+            juce::File::userApplicationDataDirectory);
+        auto configFile =
+            userAppDataDirectory.getChildFile(getApplicationName())
+                .getChildFile("config.yaml");
+        juce::File savedDirectory =
+            userAppDataDirectory.getChildFile(getApplicationName())
+                .getChildFile("load_project");
 
-        // we need to add the app internal plugins to the cache:
-        engine.getPluginManager()
-            .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
-        engine.getPluginManager()
-            .createBuiltInType<internal_plugins::DistortionPlugin>();
+        juce::File latestFile;
+        juce::ValueTree latestState;
+
+        // The project, the samples and the audio devices are read on
+        // background threads while the engine is set up on this one. The
+        // time taken by each task is written to the log.
+        using RunOn = app_services::TaskGraph::RunOn;
+        app_services::TaskGraph startup("Startup");
+
+        startup.add("plugins", [this] {
+            // we need to add the app internal plugins to the cache:
+            engine.getPluginManager()
+                .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+            engine.getPluginManager()
+                .createBuiltInType<internal_plugins::DistortionPlugin>();
+        });
 
         // this can cache all your plugins.
         /* auto &knownPluginList = engine.getPluginManager().knownPluginList;
@@ -70,35 +94,121 @@ class GuiAppApplication : public juce::JUCEApplication {
             *pluginDescriptions.getLast());
             */
 
-        auto userAppDataDirectory = juce::File::getSpecialLocation(
-            juce::File::userApplicationDataDirectory);
-        juce::File savedDirectory =
-            userAppDataDirectory.getChildFile(getApplicationName())
-                .getChildFile("load_project");
-
-        if (!savedDirectory.exists()) {
-            savedDirectory.createDirectory();
-        }
+        startup.add(
+            "project index",
+            [&] {
+                if (!savedDirectory.exists()) {
+                    savedDirectory.createDirectory();
+                }
 
-        juce::File latestFile;
-        juce::Time latestModificationTime;
-
-        if (savedDirectory.isDirectory()) {
-            juce::Array<juce::File> files = savedDirectory.findChildFiles(
-                juce::File::findFiles, false, "*.xml");
-
-            for (const auto &currentFile : files) {
-                if (currentFile.getLastModificationTime() >
-                    latestModificationTime) {
-                    latestModificationTime =
-                        currentFile.getLastModificationTime();
-                    latestFile = currentFile;
+                if (savedDirectory.isDirectory()) {
+                    if (auto latestProject =
+                            app_services::ProjectIndex::getNewest(
+                                savedDirectory))
+                        latestFile = latestProject->file;
                 }
-            }
+            },
+            {}, RunOn::background);
+
+        startup.add(
+            "project read",
+            [&] {
+                if (!latestFile.existsAsFile())
+                    return;
+
+                // changes made after the last save are kept in the journal
+                latestState = app_services::EditJournal::recover(latestFile);
+                if (!latestState.isValid())
+                    latestState = app_services::ProjectFile::read(latestFile);
+            },
+            {"project index"}, RunOn::background);
+
+        startup.add(
+            "samples", [this] { ConfigurationHelpers::initSamples(engine); },
+            {}, RunOn::background);
+
+        startup.add(
+            "sample catalog",
+            [&] {
+                // scanned in the background before a sampler is opened, the
+                // peaks of new samples are written after the listings
+                waveformCache->setDirectory(
+                    ConfigurationHelpers::getWaveformsDirectory());
+                // the user directories are watched, their changes are
+                // copied or linked before the temporary ones are listed
+                sampleCatalog->setSources(
+                    ConfigurationHelpers::getSamplesDirectory(),
+                    ConfigurationHelpers::getDrumKitsDirectory(),
+                    [this](const juce::File &source) {
+                        ConfigurationHelpers::updateUserSamples(engine,
+                                                                source);
+                    });
+                sampleCatalog->setDirectories(
+                    ConfigurationHelpers::getTempSamplesDirectory(engine),
+                    ConfigurationHelpers::getTempDrumKitsDirectory(engine));
+            },
+            {"samples"});
+
+        // the device type is created here, only its scan runs in the
+        // background
+        auto *deviceType = engine.getDeviceManager()
+                               .deviceManager.getCurrentDeviceTypeObject();
+        startup.add(
+            "audio device scan", [deviceType] { deviceType->scanForDevices(); },
+            {}, RunOn::background);
+
+        startup.add(
+            "edit",
+            [&] {
+                loadEdit(latestFile, latestState, savedDirectory, configFile);
+            },
+            {"plugins", "project read"});
+
+        startup.add(
+            "audio devices", [this] { initialiseAudioDevices(); },
+            {"audio device scan", "edit"});
+
+        startup.add(
+            "midi",
+            [&] {
+                midiCommandManager =
+                    std::make_unique<app_services::MidiCommandManager>(engine);
+                configureMidiCommandManager(configFile);
+
+                if (auto uiBehavior = dynamic_cast<ExtendedUIBehaviour *>(
+                        &engine.getUIBehaviour())) {
+                    uiBehavior->setEdit(edit.get());
+                    uiBehavior->setMidiCommandManager(midiCommandManager.get());
+                }
+            },
+            {"edit"});
+
+        startup.add(
+            "window",
+            [this] {
+                mainWindow = std::make_unique<MainWindow>(
+                    getApplicationName(), engine, *edit, *midiCommandManager);
+            },
+            {"midi", "audio devices", "sample catalog"});
+
+        if (!startup.run()) {
+            // there is no window to dismiss the splash
+            delete splash;
+            splash = nullptr;
+            quit();
+            return;
         }
 
+        // the window is showing, the splash can go with the next repaint
+        splash->deleteAfterDelay(juce::RelativeTime(), false);
+    }
+
+    void loadEdit(const juce::File &latestFile,
+                  const juce::ValueTree &latestState,
+                  const juce::File &savedDirectory, juce::File configFile) {
         if (latestFile.existsAsFile()) {
-            edit = tracktion::loadEditFromFile(engine, latestFile);
+            edit = app_services::ProjectFile::loadEdit(engine, latestState,
+                                                       latestFile);
             ConfigurationHelpers::setSavedTrackName(latestFile);
         } else {
             // Generate file name based on current date
@@ -115,8 +225,14 @@ class GuiAppApplication : public juce::JUCEApplication {
             auto seconds =
                 juce::String(currentTime.getSeconds()).paddedLeft('0', 2);
 
-            juce::String newEditFileName = "edit_" + day + month + year +
-                                           hours + minutes + seconds + ".xml";
+            auto format =
+                ConfigurationHelpers::getUseBinaryProjectFormat(configFile)
+                    ? app_services::ProjectFile::Format::binary
+                    : app_services::ProjectFile::Format::xml;
+
+            juce::String newEditFileName =
+                "edit_" + day + month + year + hours + minutes + seconds +
+                app_services::ProjectFile::getExtension(format);
 
             auto editFile = savedDirectory.getChildFile(newEditFileName);
 
@@ -130,7 +246,6 @@ class GuiAppApplication : public juce::JUCEApplication {
             for (auto track : tracktion::getAudioTracks(*edit))
                 track->setColour(appLookAndFeel.getRandomColour());
         }
-        ConfigurationHelpers::initSamples(engine);
 
         // The master track does not have the default  plugins added to it by
         // default
@@ -149,28 +264,42 @@ class GuiAppApplication : public juce::JUCEApplication {
         edit->clickTrackEnabled.setValue(true, nullptr);
         edit->setCountInMode(tracktion::Edit::CountIn::oneBar);
 
-        midiCommandManager =
-            std::make_unique<app_services::MidiCommandManager>(engine);
+        editJournal = std::make_unique<app_services::EditJournal>(
+            *edit, tracktion::EditFileOperations(*edit).getEditFile());
+    }
+
+    void configureMidiCommandManager(juce::File configFile) {
+        using Command = app_services::MidiCommandManager::Command;
+        using LogVerbosity = app_services::MidiCommandManager::LogVerbosity;
+
+        for (const auto &[name, controllerNumber] :
+             ConfigurationHelpers::getControllerMapping(configFile)) {
+            auto command =
+                app_services::MidiCommandManager::getCommandFromName(name);
+            if (command == Command::none ||
+                !juce::isPositiveAndBelow(
+                    controllerNumber,
+                    app_services::MidiCommandManager::numControllers)) {
+                juce::Logger::writeToLog("Ignoring midi mapping " + name +
+                                         ": " + juce::String(controllerNumber));
+                continue;
+            }
 
-        if (auto uiBehavior =
-                dynamic_cast<ExtendedUIBehaviour *>(&engine.getUIBehaviour())) {
-            uiBehavior->setEdit(edit.get());
-            uiBehavior->setMidiCommandManager(midiCommandManager.get());
+            midiCommandManager->mapController(command, controllerNumber);
         }
 
-        initialiseAudioDevices();
-        mainWindow = std::make_unique<MainWindow>(getApplicationName(), engine,
-                                                  *edit, *midiCommandManager);
-
-        splash->deleteAfterDelay(juce::RelativeTime::seconds(4.25), false);
+        auto verbosity = ConfigurationHelpers::getMidiLogVerbosity(configFile);
+        midiCommandManager->setLogVerbosity(
+            static_cast<LogVerbosity>(juce::jlimit(0, 2, verbosity)));
     }
 
     void initialiseAudioDevices() {
+        // the devices have been scanned by the startup tasks
         auto &deviceManager = engine.getDeviceManager().deviceManager;
-        deviceManager.getCurrentDeviceTypeObject()->scanForDevices();
         auto result = deviceManager.initialiseWithDefaultDevices(0, 2);
         if (result != "") {
-            juce::Logger::writeToLog(
+            app_services::AsyncFileLogger::write(
+                app_services::AsyncFileLogger::Level::error,
                 "Attempt to initialise default devices failed!");
         }
     }
@@ -286,12 +415,18 @@ class GuiAppApplication : public juce::JUCEApplication {
     };
 
   private:
-    std::unique_ptr<juce::FileLogger> logger;
+    std::unique_ptr<app_services::AsyncFileLogger> logger;
     std::unique_ptr<MainWindow> mainWindow;
     tracktion::Engine engine{getApplicationName(),
                              std::make_unique<ExtendedUIBehaviour>(), nullptr};
     std::unique_ptr<tracktion::Edit> edit;
+    std::unique_ptr<app_services::EditJournal> editJournal;
     std::unique_ptr<app_services::MidiCommandManager> midiCommandManager;
+    juce::SharedResourcePointer<app_services::SampleCatalog> sampleCatalog;
+    juce::SharedResourcePointer<app_services::WaveformCache> waveformCache;
+    // held for the app's lifetime so writes requested before an edit is
+    // open, like the project index at startup, don't wait for the thread
+    juce::SharedResourcePointer<app_services::EditSaveService> saveService;
     AppLookAndFeel appLookAndFeel;
     juce::SplashScreen *splash;
 };
@@ -95,6 +95,13 @@ void syncUserFilesIfNeeded(const juce::File &sourceDir,
         }
     }
 
+    // the copies of the files which have been removed
+    for (const auto &destFile :
+         targetDir.findChildFiles(juce::File::findFilesAndDirectories, true))
+        if (!sourceDir.getChildFile(destFile.getRelativePathFrom(targetDir))
+                 .exists())
+            destFile.deleteRecursively();
+
     if (allSuccessful) {
         juce::Logger::writeToLog("User " + label +
                                  " files copied (modified only). Total: " +
@@ -105,12 +112,170 @@ void syncUserFilesIfNeeded(const juce::File &sourceDir,
     }
 }
 
+static const juce::Identifier manifestDirectoryType("DIRECTORY");
+static const juce::Identifier manifestFileType("FILE");
+static const juce::Identifier manifestNameProperty("name");
+static const juce::Identifier manifestSizeProperty("size");
+static const juce::Identifier manifestModificationTimeProperty(
+    "modificationTime");
+static const juce::Identifier manifestScanTimeProperty("scanTime");
+
+// modification times have a resolution of a second on some file systems
+static constexpr juce::int64 manifestTimeResolutionMs = 2000;
+
+static bool linkUserFile(const juce::File &srcFile,
+                         const juce::File &linkFile) {
+    if (linkFile.getLinkedTarget() == srcFile)
+        return false;
+
+    // replaces a copy made before linking was enabled
+    linkFile.deleteFile();
+    if (srcFile.createSymbolicLink(linkFile, true))
+        return true;
+
+    // file systems without symbolic links
+    return srcFile.copyFileTo(linkFile);
+}
+
+static juce::ValueTree linkUserDirectory(const juce::File &sourceDir,
+                                         const juce::File &targetDir,
+                                         const juce::ValueTree &previous,
+                                         juce::int64 previousScanTime,
+                                         int &filesLinked) {
+    auto modificationTime =
+        sourceDir.getLastModificationTime().toMilliseconds();
+
+    juce::ValueTree manifest(manifestDirectoryType);
+    manifest.setProperty(manifestNameProperty, sourceDir.getFileName(),
+                         nullptr);
+    manifest.setProperty(manifestModificationTimeProperty, modificationTime,
+                         nullptr);
+
+    auto getPreviousDirectory = [&previous](const juce::File &directory) {
+        auto child = previous.getChildWithProperty(manifestNameProperty,
+                                                   directory.getFileName());
+        return child.hasType(manifestDirectoryType) ? child : juce::ValueTree();
+    };
+
+    // adding, removing or renaming a file changes its directory, the links
+    // follow changes made to the files themselves
+    if (previous.isValid() &&
+        juce::int64(previous[manifestModificationTimeProperty]) ==
+            modificationTime &&
+        modificationTime + manifestTimeResolutionMs <= previousScanTime) {
+        for (const auto &child : previous) {
+            if (child.hasType(manifestFileType)) {
+                manifest.appendChild(child.createCopy(), nullptr);
+                continue;
+            }
+
+            auto name = child[manifestNameProperty].toString();
+            auto subDir = sourceDir.getChildFile(name);
+            if (subDir.isDirectory())
+                manifest.appendChild(
+                    linkUserDirectory(subDir, targetDir.getChildFile(name),
+                                      child, previousScanTime, filesLinked),
+                    nullptr);
+        }
+
+        return manifest;
+    }
+
+    targetDir.createDirectory();
+
+    // remove the links to files that no longer exist, only the ones the
+    // previous scan made so other files of the directory are kept
+    for (const auto &entry : previous) {
+        auto name = entry[manifestNameProperty].toString();
+        if (name.isEmpty())
+            continue;
+
+        auto source = sourceDir.getChildFile(name);
+        if (entry.hasType(manifestDirectoryType) ? !source.isDirectory()
+                                                 : !source.existsAsFile())
+            targetDir.getChildFile(name).deleteRecursively();
+    }
+
+    for (const auto &child :
+         sourceDir.findChildFiles(juce::File::findFilesAndDirectories, false)) {
+        auto target = targetDir.getChildFile(child.getFileName());
+
+        if (child.isDirectory()) {
+            manifest.appendChild(
+                linkUserDirectory(child, target, getPreviousDirectory(child),
+                                  previousScanTime, filesLinked),
+                nullptr);
+            continue;
+        }
+
+        if (linkUserFile(child, target))
+            ++filesLinked;
+
+        juce::ValueTree file(manifestFileType);
+        file.setProperty(manifestNameProperty, child.getFileName(), nullptr);
+        file.setProperty(manifestSizeProperty, child.getSize(), nullptr);
+        file.setProperty(manifestModificationTimeProperty,
+                         child.getLastModificationTime().toMilliseconds(),
+                         nullptr);
+        manifest.appendChild(file, nullptr);
+    }
+
+    return manifest;
+}
+
+void linkUserFilesIfNeeded(const juce::File &sourceDir,
+                           const juce::File &targetDir,
+                           const juce::String &label) {
+    if (!sourceDir.exists()) {
+        syncUserFilesIfNeeded(sourceDir, targetDir, label);
+        return;
+    }
+
+    // next to the directory, the sampler listings show every file in it
+    auto manifestFile =
+        targetDir.getSiblingFile(targetDir.getFileName() + ".manifest");
+
+    juce::ValueTree previous;
+    if (auto input = manifestFile.createInputStream())
+        previous = juce::ValueTree::readFromStream(*input);
+
+    int filesLinked = 0;
+    auto scanTime = juce::Time::currentTimeMillis();
+    auto manifest = linkUserDirectory(
+        sourceDir, targetDir, previous,
+        juce::int64(previous.getProperty(manifestScanTimeProperty, 0)),
+        filesLinked);
+    manifest.setProperty(manifestScanTimeProperty, scanTime, nullptr);
+
+    juce::TemporaryFile temporaryFile(manifestFile);
+    {
+        juce::FileOutputStream output(temporaryFile.getFile());
+        if (output.openedOk())
+            manifest.writeToStream(output);
+    }
+
+    if (!temporaryFile.overwriteTargetFileWithTemporary())
+        juce::Logger::writeToLog("Failed to write the " + label +
+                                 " manifest: " +
+                                 manifestFile.getFullPathName());
+
+    juce::Logger::writeToLog("User " + label +
+                             " files linked (modified directories only). "
+                             "Total: " +
+                             juce::String(filesLinked));
+}
+
 void ConfigurationHelpers::initUserSamples(const juce::File &userSynthSampleDir,
                                            const juce::File &userDrumDir,
                                            const juce::File &tempSynthDir,
-                                           const juce::File &tempDrumDir) {
-    auto userAppDataDirectory = juce::File::getSpecialLocation(
-        juce::File::userApplicationDataDirectory);
+                                           const juce::File &tempDrumDir,
+                                           bool linkUserFiles) {
+    if (linkUserFiles) {
+        linkUserFilesIfNeeded(userSynthSampleDir, tempSynthDir,
+                              "synth sample");
+        linkUserFilesIfNeeded(userDrumDir, tempDrumDir, "drum kit");
+        return;
+    }
 
     syncUserFilesIfNeeded(userSynthSampleDir, tempSynthDir, "synth sample");
     syncUserFilesIfNeeded(userDrumDir, tempDrumDir, "drum kit");
@@ -138,9 +303,29 @@ void ConfigurationHelpers::initSamples(tracktion::Engine &engine) {
         createTempDirectory(engine, SAMPLES_DIRECTORY_NAME);
     auto tempDrumKitsDir =
         createTempDirectory(engine, DRUM_KITS_DIRECTORY_NAME);
+    auto configFile = userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
+                          .getChildFile("config.yaml");
     //        initBinarySamples(tempSynthSamplesDir, tempDrumKitsDir);
     initUserSamples(userSynthSampleDir, userDrumDir, tempSynthSamplesDir,
-                    tempDrumKitsDir);
+                    tempDrumKitsDir, getLinkSampleLibrary(configFile));
+}
+
+void ConfigurationHelpers::updateUserSamples(tracktion::Engine &engine,
+                                             const juce::File &userDirectory) {
+    auto configFile = juce::File::getSpecialLocation(
+                          juce::File::userApplicationDataDirectory)
+                          .getChildFile(ROOT_DIRECTORY_NAME)
+                          .getChildFile("config.yaml");
+
+    auto isDrumKits = userDirectory == getDrumKitsDirectory();
+    auto tempDir = isDrumKits ? getTempDrumKitsDirectory(engine)
+                              : getTempSamplesDirectory(engine);
+    juce::String label = isDrumKits ? "drum kit" : "synth sample";
+
+    if (getLinkSampleLibrary(configFile))
+        linkUserFilesIfNeeded(userDirectory, tempDir, label);
+    else
+        syncUserFilesIfNeeded(userDirectory, tempDir, label);
 }
 
 bool ConfigurationHelpers::getShowTitleBar(juce::File &configFile) {
@@ -193,6 +378,70 @@ double ConfigurationHelpers::getHeight(juce::File &configFile) {
     return 480;
 }
 
+std::map<juce::String, int>
+ConfigurationHelpers::getControllerMapping(juce::File &configFile) {
+    std::map<juce::String, int> mapping;
+
+    if (configFile.exists()) {
+        YAML::Node rootNode =
+            YAML::LoadFile(configFile.getFullPathName().toStdString());
+        YAML::Node config = rootNode["config"];
+        if (config) {
+            if (config["midi"] && config["midi"]["controllers"]) {
+                for (const auto &controller : config["midi"]["controllers"]) {
+                    auto name = controller.first.as<std::string>();
+                    mapping[juce::String(name)] = controller.second.as<int>();
+                }
+            }
+        }
+    }
+
+    return mapping;
+}
+
+int ConfigurationHelpers::getMidiLogVerbosity(juce::File &configFile) {
+    if (configFile.exists()) {
+        YAML::Node rootNode =
+            YAML::LoadFile(configFile.getFullPathName().toStdString());
+        YAML::Node config = rootNode["config"];
+        if (config) {
+            if (config["midi"] && config["midi"]["log-verbosity"])
+                return config["midi"]["log-verbosity"].as<int>();
+        }
+    }
+
+    // Default to not logging midi messages
+    return 0;
+}
+
+bool ConfigurationHelpers::getUseBinaryProjectFormat(juce::File &configFile) {
+    if (configFile.exists()) {
+        YAML::Node rootNode =
+            YAML::LoadFile(configFile.getFullPathName().toStdString());
+        YAML::Node config = rootNode["config"];
+        if (config)
+            if (config["project-format"])
+                return config["project-format"].as<std::string>() == "binary";
+    }
+
+    // Default to XML projects
+    return false;
+}
+
+bool ConfigurationHelpers::getLinkSampleLibrary(juce::File &configFile) {
+    if (configFile.exists()) {
+        YAML::Node rootNode =
+            YAML::LoadFile(configFile.getFullPathName().toStdString());
+        YAML::Node config = rootNode["config"];
+        if (config)
+            if (config["sample-library"])
+                return config["sample-library"].as<std::string>() == "link";
+    }
+
+    // Default to copying the user samples
+    return false;
+}
+
 juce::File ConfigurationHelpers::getSamplesDirectory() {
     auto userAppDataDirectory = juce::File::getSpecialLocation(
         juce::File::userApplicationDataDirectory);
@@ -207,6 +456,13 @@ juce::File ConfigurationHelpers::getDrumKitsDirectory() {
         .getChildFile(DRUM_KITS_DIRECTORY_NAME);
 }
 
+juce::File ConfigurationHelpers::getWaveformsDirectory() {
+    auto userAppDataDirectory = juce::File::getSpecialLocation(
+        juce::File::userApplicationDataDirectory);
+    return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
+        .getChildFile(WAVEFORMS_DIRECTORY_NAME);
+}
+
 juce::File
 ConfigurationHelpers::getTempSamplesDirectory(tracktion::Engine &engine) {
     return engine.getTemporaryFileManager().getTempFile(SAMPLES_DIRECTORY_NAME);
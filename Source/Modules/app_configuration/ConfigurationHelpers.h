@@ -1,5 +1,6 @@
 #pragma once
 #include <juce_core/juce_core.h>
+#include <map>
 #include <tracktion_engine/tracktion_engine.h>
 
 class ConfigurationHelpers {
@@ -7,16 +8,46 @@ class ConfigurationHelpers {
     static inline const juce::String ROOT_DIRECTORY_NAME = "LMN-3";
     static inline const juce::String SAMPLES_DIRECTORY_NAME = "samples";
     static inline const juce::String DRUM_KITS_DIRECTORY_NAME = "drum_kits";
+    static inline const juce::String WAVEFORMS_DIRECTORY_NAME = ".waveforms";
     static juce::File SAVED_TRACK_NAME;
 
     static juce::File getSamplesDirectory();
     static juce::File getDrumKitsDirectory();
+    /**
+     * Peak files of the sample waveforms, kept between sessions
+     */
+    static juce::File getWaveformsDirectory();
     static juce::File getTempSamplesDirectory(tracktion::Engine &engine);
     static juce::File getTempDrumKitsDirectory(tracktion::Engine &engine);
     static void initSamples(tracktion::Engine &engine);
+    /**
+     * Copy or link the changes made to one of the user sample directories
+     * into its temporary directory
+     */
+    static void updateUserSamples(tracktion::Engine &engine,
+                                  const juce::File &userDirectory);
     static bool getShowTitleBar(juce::File &configFile);
     static double getWidth(juce::File &configFile);
     static double getHeight(juce::File &configFile);
+    /**
+     * Controller numbers of the commands listed under `midi: controllers:`,
+     * keyed by command name
+     */
+    static std::map<juce::String, int>
+    getControllerMapping(juce::File &configFile);
+    /**
+     * 0 logs nothing, 1 the unmapped midi messages and 2 every message
+     */
+    static int getMidiLogVerbosity(juce::File &configFile);
+    /**
+     * True when new projects should use the compressed binary format
+     */
+    static bool getUseBinaryProjectFormat(juce::File &configFile);
+    /**
+     * True when the user samples should be linked into the temporary
+     * directories instead of copied
+     */
+    static bool getLinkSampleLibrary(juce::File &configFile);
     static void setSavedTrackName(const juce::File &newValue);
     static juce::File getSavedTrackName();
     static juce::String getApplicationName();
@@ -32,7 +63,8 @@ class ConfigurationHelpers {
     static void initUserSamples(const juce::File &userSynthSampleDir,
                                 const juce::File &userDrumDir,
                                 const juce::File &tempSynthDir,
-                                const juce::File &tempDrumDir);
+                                const juce::File &tempDrumDir,
+                                bool linkUserFiles);
     static juce::File createTempDirectory(tracktion::Engine &engine,
                                           const juce::String &folderName);
 };
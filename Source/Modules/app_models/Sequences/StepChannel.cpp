@@ -30,19 +30,35 @@ StepChannel::StepChannel(juce::ValueTree v) : state(v) {
 
     pattern.setConstrainer(patternConstrainer);
     pattern.referTo(state, IDs::stepPattern, nullptr, "0000000000000000");
+
+    readPattern(pattern.get());
+    state.addListener(this);
 }
 
+StepChannel::~StepChannel() { state.removeListener(this); }
+
 void StepChannel::setIndex(int index) { channelIndex.setValue(index, nullptr); }
 
 void StepChannel::setPattern(juce::BigInteger &b) {
-    pattern.setValue(b.toString(2), nullptr);
+    for (int word = 0; word < numberOfWords; word++) {
+        auto low = std::uint64_t(b.getBitRangeAsInt(word * 64, 32));
+        auto high = std::uint64_t(b.getBitRangeAsInt(word * 64 + 32, 32));
+        notes[size_t(word)] = low | (high << 32);
+    }
+
+    dirty = true;
+    flush();
 }
 
 int StepChannel::getIndex() { return channelIndex.get(); }
 
 juce::BigInteger StepChannel::getPattern() {
     juce::BigInteger b;
-    b.parseString(pattern.get(), 2);
+    for (int word = 0; word < numberOfWords; word++) {
+        auto bits = notes[size_t(word)];
+        b.setBitRangeAsInt(word * 64, 32, juce::uint32(bits & 0xffffffff));
+        b.setBitRangeAsInt(word * 64 + 32, 32, juce::uint32(bits >> 32));
+    }
     return b;
 }
 
@@ -54,21 +70,110 @@ juce::BigInteger StepChannel::getPattern() {
 void StepChannel::setNote(int noteIndex, int value) {
     jassert(value >= 0 && value < 8);
 
-    juce::BigInteger b(getPattern());
-    // octal requires 3 bits
-    b.setBitRangeAsInt(noteIndex * 3, 3, value);
-    setPattern(b);
+    if (!juce::isPositiveAndBelow(noteIndex * 3, maxNumberOfVelocityBits))
+        return;
+
+    // octal requires 3 bits, a note may overlap 2 words
+    auto bit = noteIndex * 3;
+    auto word = size_t(bit / 64);
+    auto shift = bit % 64;
+    auto bits = std::uint64_t(value & 7);
+
+    notes[word] &= ~(std::uint64_t(7) << shift);
+    notes[word] |= bits << shift;
+    if (shift > 61) {
+        notes[word + 1] &= ~(std::uint64_t(7) >> (64 - shift));
+        notes[word + 1] |= bits >> (64 - shift);
+    }
+
+    dirty = true;
 }
 
 /**
  * Get the note intensity between 0-7
  */
-int StepChannel::getNote(int noteIndex) {
-    return getPattern().getBitRangeAsInt(noteIndex * 3, 3);
+int StepChannel::getNote(int noteIndex) const {
+    if (!juce::isPositiveAndBelow(noteIndex * 3, maxNumberOfVelocityBits))
+        return 0;
+
+    auto bit = noteIndex * 3;
+    auto word = size_t(bit / 64);
+    auto shift = bit % 64;
+
+    auto bits = notes[word] >> shift;
+    if (shift > 61)
+        bits |= notes[word + 1] << (64 - shift);
+
+    return int(bits & 7);
+}
+
+void StepChannel::clearNotes() {
+    notes.fill(0);
+    dirty = true;
+}
+
+void StepChannel::flush() {
+    if (!dirty)
+        return;
+
+    isFlushing = true;
+    pattern.setValue(writePattern(), nullptr);
+    isFlushing = false;
+    dirty = false;
 }
 
 int StepChannel::getMaxNumberOfNotes(int notesPerMeasure) {
     return maxNumberOfMeasures * notesPerMeasure;
 }
 
+/**
+ * Patterns are stored as `juce::BigInteger::toString(2)` did: most significant
+ * bit first. Any other character is ignored and only the last
+ * maxNumberOfVelocityBits digits are kept.
+ */
+void StepChannel::readPattern(const juce::String &binaryPattern) {
+    notes.fill(0);
+
+    auto digits = binaryPattern.toRawUTF8();
+    int bit = 0;
+    for (auto i = int(binaryPattern.getNumBytesAsUTF8()) - 1;
+         i >= 0 && bit < maxNumberOfVelocityBits; i--) {
+        if (digits[i] != '0' && digits[i] != '1')
+            continue;
+
+        if (digits[i] == '1')
+            notes[size_t(bit / 64)] |= std::uint64_t(1) << (bit % 64);
+
+        bit++;
+    }
+
+    dirty = false;
+}
+
+juce::String StepChannel::writePattern() const {
+    char digits[numberOfWords * 64];
+    size_t length = 0;
+
+    for (int bit = numberOfWords * 64 - 1; bit >= 0; bit--) {
+        bool isSet = (notes[size_t(bit / 64)] >> (bit % 64)) & 1;
+        // skip leading zeros
+        if (isSet || length > 0)
+            digits[length++] = isSet ? '1' : '0';
+    }
+
+    if (length == 0)
+        return "0";
+
+    return juce::String(digits, length);
+}
+
+void StepChannel::valueTreePropertyChanged(
+    juce::ValueTree &treeWhosePropertyHasChanged,
+    const juce::Identifier &property) {
+    // the pattern has been replaced from outside, e.g. when loading an edit
+    if (!isFlushing && treeWhosePropertyHasChanged == state &&
+        property == IDs::stepPattern)
+        readPattern(state[IDs::stepPattern].toString());
+}
+
 } // namespace app_models
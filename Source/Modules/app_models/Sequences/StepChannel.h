@@ -7,9 +7,10 @@ const juce::Identifier stepChannelIndex("channelIndex");
 const juce::Identifier stepPattern("stepPattern");
 
 } // namespace IDs
-class StepChannel {
+class StepChannel : private juce::ValueTree::Listener {
   public:
     StepChannel(juce::ValueTree v);
+    ~StepChannel() override;
 
     void setIndex(int index);
     void setPattern(juce::BigInteger &b);
@@ -18,12 +19,24 @@ class StepChannel {
     juce::BigInteger getPattern();
     /**
      * Set the note intensity between 0 & 7
+     * Only the in-memory grid is updated, call `flush()` to write the
+     * pattern to the value tree.
      */
     void setNote(int noteIndex, int value);
     /**
      * Return the note intensity between 0 & 7
      */
-    int getNote(int noteIndex);
+    int getNote(int noteIndex) const;
+    /**
+     * Set every note intensity to 0
+     */
+    void clearNotes();
+    /**
+     * Serialize the in-memory grid into the `stepPattern` property if it has
+     * been modified since the last flush.
+     */
+    void flush();
+    bool needsFlush() const { return dirty; }
     /**
      * Maximum of notes based on notes per measure
      * Initially we wanted 4 notes in 4 measures but with if we increase the
@@ -42,6 +55,25 @@ class StepChannel {
   private:
     tracktion::ConstrainedCachedValue<int> channelIndex;
     tracktion::ConstrainedCachedValue<juce::String> pattern;
+
+    /**
+     * Live copy of the pattern: 64 notes × 3 bits packed in 3 words, with
+     * the same bit layout as the `stepPattern` binary string (note 0 is
+     * the lowest 3 bits).
+     */
+    static constexpr int numberOfWords = 3;
+    std::array<std::uint64_t, numberOfWords> notes{};
+    bool dirty = false;
+    bool isFlushing = false;
+
+    /**
+     * Read a `stepPattern` binary string into the in-memory grid
+     */
+    void readPattern(const juce::String &binaryPattern);
+    juce::String writePattern() const;
+
+    void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
+                                  const juce::Identifier &property) override;
 };
 
 } // namespace app_models
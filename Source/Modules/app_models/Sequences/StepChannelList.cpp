@@ -3,6 +3,7 @@ namespace app_models {
 StepChannelList::StepChannelList(const juce::ValueTree &v)
     : tracktion::ValueTreeObjectList<StepChannel>(v) {
     rebuildObjects();
+    rebuildChannelsByIndex();
 }
 
 StepChannelList::~StepChannelList() { freeObjects(); }
@@ -17,9 +18,39 @@ StepChannel *StepChannelList::createNewObject(const juce::ValueTree &v) {
 
 void StepChannelList::deleteObject(StepChannel *sc) { delete sc; }
 
-void StepChannelList::newObjectAdded(StepChannel * /*sc*/) {}
+void StepChannelList::newObjectAdded(StepChannel *sc) {
+    auto index = sc->getIndex();
+    if (juce::isPositiveAndBelow(index, channelsByIndex.size()) &&
+        channelsByIndex.getUnchecked(index) == nullptr)
+        channelsByIndex.setUnchecked(index, sc);
+}
+
+void StepChannelList::objectRemoved(StepChannel * /*sc*/) {
+    // another channel may share the removed index
+    rebuildChannelsByIndex();
+}
 
-void StepChannelList::objectRemoved(StepChannel * /*sc*/) {}
+void StepChannelList::objectOrderChanged() { rebuildChannelsByIndex(); }
+
+StepChannel *StepChannelList::getChannel(int index) const {
+    return channelsByIndex[index];
+}
 
-void StepChannelList::objectOrderChanged() {}
+void StepChannelList::rebuildChannelsByIndex() {
+    channelsByIndex.clearQuick();
+    channelsByIndex.insertMultiple(0, nullptr,
+                                   StepChannel::maxNumberOfChannels);
+
+    // the first channel with a given index wins, as the linear scan did
+    for (auto channel : objects)
+        newObjectAdded(channel);
+}
+
+void StepChannelList::valueTreePropertyChanged(
+    juce::ValueTree &treeWhosePropertyHasChanged,
+    const juce::Identifier &property) {
+    if (property == IDs::stepChannelIndex &&
+        isSuitableType(treeWhosePropertyHasChanged))
+        rebuildChannelsByIndex();
+}
 } // namespace app_models
@@ -16,6 +16,20 @@ class StepChannelList : public tracktion::ValueTreeObjectList<StepChannel> {
     void objectRemoved(StepChannel *t) override;
 
     void objectOrderChanged() override;
+
+    /**
+     * Return the channel with the given channel index or nullptr
+     */
+    StepChannel *getChannel(int index) const;
+
+  private:
+    // channels indexed by their channel index, kept in sync with objects
+    juce::Array<StepChannel *> channelsByIndex;
+
+    void rebuildChannelsByIndex();
+
+    void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
+                                  const juce::Identifier &property) override;
 };
 
 } // namespace app_models
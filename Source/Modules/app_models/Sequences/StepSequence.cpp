@@ -9,6 +9,11 @@ StepSequence::StepSequence(juce::ValueTree v) : state(v), channelList(v) {
     }
 }
 
+StepSequence::~StepSequence() {
+    cancelPendingUpdate();
+    flush();
+}
+
 void StepSequence::init() {
     for (int i = 0; i < StepChannel::maxNumberOfChannels; i++) {
         juce::ValueTree channelTree(IDs::STEP_CHANNEL);
@@ -20,16 +25,44 @@ void StepSequence::init() {
 }
 
 void StepSequence::clear() {
-    state.removeAllChildren(nullptr);
-    init();
+    cancelPendingUpdate();
+
+    if (channelList.objects.size() != StepChannel::maxNumberOfChannels) {
+        state.removeAllChildren(nullptr);
+        init();
+        return;
+    }
+
+    // reset patterns in place rather than rebuilding every channel
+    for (auto channel : channelList.objects) {
+        channel->clearNotes();
+        channel->flush();
+    }
 }
 
 StepChannel *StepSequence::getChannel(int index) {
-    for (auto channel : channelList.objects)
-        if (channel->getIndex() == index)
-            return channel;
+    return channelList.getChannel(index);
+}
 
-    return nullptr;
+int StepSequence::getNote(int channel, int noteIndex) {
+    if (auto stepChannel = getChannel(channel))
+        return stepChannel->getNote(noteIndex);
+
+    return 0;
+}
+
+void StepSequence::setNote(int channel, int noteIndex, int value) {
+    if (auto stepChannel = getChannel(channel)) {
+        stepChannel->setNote(noteIndex, value);
+        triggerAsyncUpdate();
+    }
 }
 
+void StepSequence::flush() {
+    for (auto channel : channelList.objects)
+        channel->flush();
+}
+
+void StepSequence::handleAsyncUpdate() { flush(); }
+
 } // namespace app_models
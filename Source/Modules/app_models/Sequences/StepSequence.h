@@ -6,11 +6,25 @@ namespace IDs {
 const juce::Identifier STEP_SEQUENCE("STEP_SEQUENCE");
 
 }
-class StepSequence {
+class StepSequence : private juce::AsyncUpdater {
   public:
     explicit StepSequence(juce::ValueTree v);
+    ~StepSequence() override;
 
     StepChannel *getChannel(int index);
+    /**
+     * Return the note intensity between 0 & 7, 0 for unknown channels
+     */
+    int getNote(int channel, int noteIndex);
+    /**
+     * Set the note intensity between 0 & 7
+     * Patterns are written to the value tree once the message thread is idle.
+     */
+    void setNote(int channel, int noteIndex, int value);
+    /**
+     * Write pending pattern changes to the value tree now
+     */
+    void flush();
     /**
      * remove and init patterns
      */
@@ -21,6 +35,7 @@ class StepSequence {
      * init patterns
      */
     void init();
+    void handleAsyncUpdate() override;
     juce::ValueTree state;
     StepChannelList channelList;
 };
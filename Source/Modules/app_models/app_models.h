@@ -25,6 +25,7 @@ namespace app_models {
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include <array>
 #include <functional>
 
 // Utilities
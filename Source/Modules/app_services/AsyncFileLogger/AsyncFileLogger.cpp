@@ -0,0 +1,161 @@
+#include "AsyncFileLogger.h"
+
+namespace app_services {
+
+AsyncFileLogger::AsyncFileLogger(const juce::File &file,
+                                 const juce::String &welcomeMessage,
+                                 juce::int64 maxFileSizeBytes,
+                                 int numberOfBackups)
+    : juce::Thread("Log writer"), logFile(file),
+      maxFileSize(maxFileSizeBytes), numBackups(numberOfBackups),
+      entries(size_t(capacity)) {
+    logFile.create();
+
+    if (welcomeMessage.isNotEmpty())
+        log(Level::info, welcomeMessage);
+
+    startThread(juce::Thread::Priority::low);
+}
+
+AsyncFileLogger::~AsyncFileLogger() {
+    stopThread(2000);
+
+    // messages logged while the thread was stopping
+    writePendingMessages();
+}
+
+juce::File
+AsyncFileLogger::getDefaultLogFile(const juce::String &applicationName,
+                                   const juce::String &fileName) {
+    return juce::FileLogger::getSystemLogFileFolder()
+        .getChildFile(applicationName)
+        .getChildFile(fileName);
+}
+
+void AsyncFileLogger::log(Level level, const juce::String &message) {
+    if (level < minimumLevel.load())
+        return;
+
+    bool bufferIsFilling = false;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(writeLock);
+
+        if (fifo.getFreeSpace() == 0) {
+            numDroppedMessages++;
+            totalDroppedMessages++;
+            return;
+        }
+
+        fifo.write(1).forEach([&](int index) {
+            auto &entry = entries[size_t(index)];
+            entry.level = level;
+            entry.time = juce::Time::currentTimeMillis();
+            // truncates long messages without allocating
+            message.copyToUTF8(entry.text, size_t(maxMessageBytes));
+        });
+
+        bufferIsFilling = fifo.getNumReady() >= capacity / 2;
+    }
+
+    if (bufferIsFilling)
+        notify();
+}
+
+void AsyncFileLogger::setMinimumLevel(Level newLevel) {
+    minimumLevel = newLevel;
+}
+
+void AsyncFileLogger::write(Level level, const juce::String &message) {
+    if (auto logger =
+            dynamic_cast<AsyncFileLogger *>(juce::Logger::getCurrentLogger()))
+        logger->log(level, message);
+    else
+        juce::Logger::writeToLog(message);
+}
+
+void AsyncFileLogger::flush() { writePendingMessages(); }
+
+void AsyncFileLogger::logMessage(const juce::String &message) {
+    log(Level::info, message);
+}
+
+void AsyncFileLogger::run() {
+    while (!threadShouldExit()) {
+        wait(flushIntervalMs);
+        writePendingMessages();
+    }
+}
+
+void AsyncFileLogger::writePendingMessages() {
+    // the file lock also makes this the only reader of the fifo
+    const juce::ScopedLock lock(fileLock);
+
+    juce::MemoryOutputStream batch;
+
+    if (auto dropped = numDroppedMessages.exchange(0))
+        batch << juce::Time::getCurrentTime().formatted("%Y-%m-%d %H:%M:%S")
+              << " [" << getLevelName(Level::warning) << "] Dropped "
+              << dropped << " log messages" << juce::newLine;
+
+    fifo.read(fifo.getNumReady()).forEach([&](int index) {
+        const auto &entry = entries[size_t(index)];
+        juce::Time time(entry.time);
+
+        batch << time.formatted("%Y-%m-%d %H:%M:%S") << "."
+              << juce::String(time.getMilliseconds()).paddedLeft('0', 3)
+              << " [" << getLevelName(entry.level) << "] "
+              << juce::String::fromUTF8(entry.text) << juce::newLine;
+    });
+
+    if (batch.getDataSize() == 0)
+        return;
+
+    rotateIfNeeded();
+
+    juce::FileOutputStream output(logFile);
+    if (output.openedOk()) {
+        output.write(batch.getData(), batch.getDataSize());
+        output.flush();
+    }
+}
+
+void AsyncFileLogger::rotateIfNeeded() {
+    if (logFile.getSize() < maxFileSize)
+        return;
+
+    auto getBackupFile = [this](int number) {
+        return logFile.getSiblingFile(logFile.getFileNameWithoutExtension() +
+                                      "." + juce::String(number) +
+                                      logFile.getFileExtension());
+    };
+
+    if (numBackups <= 0) {
+        logFile.deleteFile();
+        return;
+    }
+
+    getBackupFile(numBackups).deleteFile();
+    for (int i = numBackups - 1; i >= 1; i--)
+        if (getBackupFile(i).existsAsFile())
+            getBackupFile(i).moveFileTo(getBackupFile(i + 1));
+
+    logFile.moveFileTo(getBackupFile(1));
+}
+
+const char *AsyncFileLogger::getLevelName(Level level) {
+    switch (level) {
+    case Level::debug:
+        return "DEBUG";
+    case Level::info:
+        return "INFO";
+    case Level::warning:
+        return "WARNING";
+    case Level::error:
+        return "ERROR";
+    default:
+        return "";
+    }
+}
+
+} // namespace app_services
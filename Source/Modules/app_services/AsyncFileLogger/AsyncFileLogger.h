@@ -0,0 +1,89 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Logger writing to a file from a background thread.
+ * Messages are copied into a preallocated ring buffer by the calling thread
+ * and written in batches, so logging never waits on the storage. When the
+ * buffer is full messages are dropped and the number of dropped messages is
+ * written to the log.
+ */
+class AsyncFileLogger : public juce::Logger, private juce::Thread {
+  public:
+    enum class Level { debug, info, warning, error };
+
+    /**
+     * When the log file grows past maxFileSizeBytes it's renamed with a
+     * numbered suffix (log.1.txt, log.2.txt...), keeping numberOfBackups files.
+     */
+    explicit AsyncFileLogger(const juce::File &file,
+                             const juce::String &welcomeMessage = {},
+                             juce::int64 maxFileSizeBytes = 1024 * 1024,
+                             int numberOfBackups = 2);
+    ~AsyncFileLogger() override;
+
+    /**
+     * Default application log file, in the same location as
+     * `juce::FileLogger::createDefaultAppLogger()`
+     */
+    static juce::File getDefaultLogFile(const juce::String &applicationName,
+                                        const juce::String &fileName);
+
+    void log(Level level, const juce::String &message);
+    /**
+     * Messages below this level are ignored
+     */
+    void setMinimumLevel(Level newLevel);
+    Level getMinimumLevel() const { return minimumLevel.load(); }
+
+    /**
+     * Log with a level through the current logger. When it isn't an
+     * AsyncFileLogger the message is passed to `juce::Logger::writeToLog`.
+     */
+    static void write(Level level, const juce::String &message);
+
+    /**
+     * Wait until every message logged so far has been written
+     */
+    void flush();
+
+    int getNumDroppedMessages() const { return totalDroppedMessages.load(); }
+    const juce::File &getLogFile() const { return logFile; }
+
+    static constexpr int capacity = 512;
+    static constexpr int maxMessageBytes = 512;
+
+  private:
+    struct Entry {
+        Level level;
+        juce::int64 time;
+        char text[maxMessageBytes];
+    };
+
+    juce::File logFile;
+    juce::int64 maxFileSize;
+    int numBackups;
+
+    juce::AbstractFifo fifo{capacity};
+    std::vector<Entry> entries;
+    // only taken by the threads logging messages, the writer never locks
+    juce::SpinLock writeLock;
+    std::atomic<Level> minimumLevel{Level::info};
+    std::atomic<int> numDroppedMessages{0};
+    std::atomic<int> totalDroppedMessages{0};
+
+    // batches are written after this delay, or sooner when the buffer fills
+    static constexpr int flushIntervalMs = 500;
+    juce::CriticalSection fileLock;
+
+    void logMessage(const juce::String &message) override;
+    void run() override;
+
+    void writePendingMessages();
+    void rotateIfNeeded();
+    static const char *getLevelName(Level level);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AsyncFileLogger)
+};
+
+} // namespace app_services
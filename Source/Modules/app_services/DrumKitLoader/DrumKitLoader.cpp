@@ -0,0 +1,145 @@
+#include "DrumKitLoader.h"
+
+namespace app_services {
+
+class DrumKitLoader::LoadJob : public juce::ThreadPoolJob {
+  public:
+    LoadJob(DrumKitLoader &l, int g, std::vector<Sound> s)
+        : juce::ThreadPoolJob("Drum kit load"), loader(l), jobGeneration(g),
+          sounds(std::move(s)) {}
+
+    JobStatus runJob() override {
+        // a newer kit has been requested
+        auto isStale = [this] {
+            return shouldExit() || loader.generation != jobGeneration;
+        };
+
+        for (auto &sound : sounds) {
+            if (isStale())
+                break;
+
+            sound.length =
+                tracktion::AudioFile(loader.engine, sound.file).getLength();
+            readAhead(sound.file, isStale);
+        }
+
+        if (!isStale())
+            loader.prepared(jobGeneration, std::move(sounds));
+
+        loader.finished(jobGeneration);
+        return jobHasFinished;
+    }
+
+    bool belongsTo(const DrumKitLoader &l) const { return &loader == &l; }
+
+  private:
+    DrumKitLoader &loader;
+    const int jobGeneration;
+    std::vector<Sound> sounds;
+};
+
+// selects the jobs of one loader in the shared pool
+class DrumKitLoader::OwnJobs : public juce::ThreadPool::JobSelector {
+  public:
+    explicit OwnJobs(DrumKitLoader &l) : loader(l) {}
+
+    bool isJobSuitable(juce::ThreadPoolJob *job) override {
+        auto *loadJob = dynamic_cast<LoadJob *>(job);
+        return loadJob != nullptr && loadJob->belongsTo(loader);
+    }
+
+  private:
+    DrumKitLoader &loader;
+};
+
+DrumKitLoader::DrumKitLoader(tracktion::Engine &e) : engine(e) {}
+
+DrumKitLoader::~DrumKitLoader() {
+    ++generation;
+    // the running job stops within one read, it must be gone before the
+    // loader is
+    removeOwnJobs(4000);
+    cancelPendingUpdate();
+}
+
+void DrumKitLoader::load(std::vector<Sound> sounds, Callback callback) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto jobGeneration = ++generation;
+
+    {
+        const juce::ScopedLock lock(resultLock);
+        pendingCallback = std::move(callback);
+    }
+
+    // the running job stops within one read
+    removeOwnJobs(0);
+    sharedPool->threadPool.addJob(
+        new LoadJob(*this, jobGeneration, std::move(sounds)), true);
+}
+
+void DrumKitLoader::cancel() {
+    finished(++generation);
+    removeOwnJobs(0);
+}
+
+bool DrumKitLoader::isLoading() const {
+    return finishedGeneration != generation || isUpdatePending();
+}
+
+void DrumKitLoader::prepared(int jobGeneration, std::vector<Sound> sounds) {
+    {
+        const juce::ScopedLock lock(resultLock);
+        if (jobGeneration != generation)
+            return;
+
+        preparedSounds = std::move(sounds);
+        preparedGeneration = jobGeneration;
+    }
+
+    triggerAsyncUpdate();
+}
+
+void DrumKitLoader::finished(int jobGeneration) {
+    // a stopped job may end after a newer request has been cancelled
+    auto latest = finishedGeneration.load();
+    while (latest < jobGeneration &&
+           !finishedGeneration.compare_exchange_weak(latest, jobGeneration)) {
+    }
+}
+
+void DrumKitLoader::removeOwnJobs(int timeOutMilliseconds) {
+    OwnJobs ownJobs(*this);
+    sharedPool->threadPool.removeAllJobs(true, timeOutMilliseconds, &ownJobs);
+}
+
+void DrumKitLoader::handleAsyncUpdate() {
+    std::vector<Sound> sounds;
+    Callback callback;
+
+    {
+        const juce::ScopedLock lock(resultLock);
+        if (preparedGeneration != generation)
+            return;
+
+        sounds = std::move(preparedSounds);
+        callback = pendingCallback;
+        preparedGeneration = -1;
+    }
+
+    if (callback)
+        callback(sounds);
+}
+
+void DrumKitLoader::readAhead(const juce::File &file,
+                              const std::function<bool()> &shouldStop) {
+    juce::FileInputStream input(file);
+    if (!input.openedOk())
+        return;
+
+    juce::HeapBlock<char> buffer(65536);
+    while (!shouldStop() && input.read(buffer, 65536) > 0) {
+    }
+}
+
+} // namespace app_services
@@ -0,0 +1,73 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Prepares the sounds of a drum kit on a background thread.
+ * The length of every sample is read and the files are read ahead into the
+ * file system cache, the sampler still decodes them on the message thread
+ * when the kit is applied. Requesting another kit cancels the one being
+ * prepared and only the last requested kit is delivered, so scrolling
+ * through kits doesn't queue up loads. All loaders share one thread.
+ */
+class DrumKitLoader : private juce::AsyncUpdater {
+  public:
+    struct Sound {
+        juce::File file;
+        int noteNumber = 0;
+        double length = 0.0;
+    };
+
+    using Callback = std::function<void(const std::vector<Sound> &)>;
+
+    explicit DrumKitLoader(tracktion::Engine &e);
+    ~DrumKitLoader() override;
+
+    /**
+     * Prepare the sounds, the callback is called on the message thread once
+     * they are ready unless another kit has been requested in the meantime
+     */
+    void load(std::vector<Sound> sounds, Callback callback);
+    /**
+     * Drop the kit being prepared
+     */
+    void cancel();
+    bool isLoading() const;
+
+  private:
+    class LoadJob;
+    class OwnJobs;
+
+    struct SharedPool {
+        juce::ThreadPool threadPool{1};
+    };
+
+    tracktion::Engine &engine;
+    juce::SharedResourcePointer<SharedPool> sharedPool;
+
+    // incremented by every request, a prepared kit is only delivered if no
+    // request has been made since
+    std::atomic<int> generation{0};
+    // the latest generation whose job has ended or which has been cancelled
+    std::atomic<int> finishedGeneration{0};
+
+    juce::CriticalSection resultLock;
+    std::vector<Sound> preparedSounds;
+    int preparedGeneration = -1;
+    Callback pendingCallback;
+
+    void prepared(int jobGeneration, std::vector<Sound> sounds);
+    void finished(int jobGeneration);
+    void removeOwnJobs(int timeOutMilliseconds);
+    void handleAsyncUpdate() override;
+
+    /**
+     * Reads the file into the file system cache, returns early once
+     * shouldStop returns true
+     */
+    static void readAhead(const juce::File &file,
+                          const std::function<bool()> &shouldStop);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumKitLoader)
+};
+
+} // namespace app_services
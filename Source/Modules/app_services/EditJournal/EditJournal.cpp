@@ -0,0 +1,353 @@
+#include "EditJournal.h"
+
+namespace app_services {
+
+EditJournal::EditJournal(tracktion::Edit &e, const juce::File &file)
+    : juce::Thread("Edit journal"), edit(e), projectFile(file),
+      journalFile(getJournalFile(file)) {
+    // the journal always starts from the state the edit was loaded with
+    compact();
+    edit.state.addListener(this);
+    saveService->addListener(this);
+
+    startThread();
+    startTimer(flushIntervalMs);
+}
+
+EditJournal::~EditJournal() {
+    stopTimer();
+    saveService->removeListener(this);
+    edit.state.removeListener(this);
+    flush();
+
+    // the thread writes the remaining tasks before exiting
+    stopThread(10000);
+}
+
+juce::File EditJournal::getJournalFile(const juce::File &projectFile) {
+    return projectFile.getSiblingFile(projectFile.getFileName() + ".journal");
+}
+
+juce::ValueTree EditJournal::recover(const juce::File &projectFile) {
+    auto file = getJournalFile(projectFile);
+    if (!file.existsAsFile())
+        return {};
+
+    juce::FileInputStream input(file);
+    if (!input.openedOk() || input.readInt() != magicNumber)
+        return {};
+
+    // the project file has been replaced, by loading another project with
+    // the same name for example
+    auto projectModificationTime = input.readInt64();
+    input.readInt64(); // session ID
+    if (projectModificationTime !=
+        projectFile.getLastModificationTime().toMilliseconds())
+        return {};
+
+    auto state = juce::ValueTree::readFromStream(input);
+    if (!state.hasType(tracktion::IDs::EDIT))
+        return {};
+
+    int numChanges = 0;
+    while (!input.isExhausted()) {
+        auto size = input.readCompressedInt();
+
+        // the last record was interrupted while being written
+        if (size <= 0 || input.getNumBytesRemaining() < size)
+            break;
+
+        juce::MemoryBlock record;
+        input.readIntoMemoryBlock(record, size);
+
+        juce::MemoryInputStream recordInput(record, false);
+        if (!applyRecord(state, recordInput)) {
+            AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                                   "Invalid record in journal: " +
+                                       file.getFullPathName());
+            break;
+        }
+
+        numChanges++;
+    }
+
+    juce::Logger::writeToLog("Recovered " + juce::String(numChanges) +
+                             " changes from journal: " +
+                             file.getFullPathName());
+    return state;
+}
+
+void EditJournal::flush() {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    writeChangedProperties();
+    if (records.getDataSize() == 0)
+        return;
+
+    journalSize += juce::int64(records.getDataSize());
+    addTask({{}, 0, records.getMemoryBlock()});
+    records.reset();
+}
+
+void EditJournal::compact() {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // plugins write their state to the tree when flushed, the snapshot
+    // includes every change recorded so far
+    edit.flushState();
+    changedProperties.clear();
+    records.reset();
+    journalSize = 0;
+
+    addTask({edit.state.createCopy(),
+             projectFile.getLastModificationTime().toMilliseconds(),
+             {}});
+}
+
+void EditJournal::valueTreePropertyChanged(juce::ValueTree &tree,
+                                           const juce::Identifier &property) {
+    // no structural change happened since the pending changes were
+    // recorded, their paths are still the ones of the trees
+    auto alreadyChanged =
+        std::find_if(changedProperties.begin(), changedProperties.end(),
+                     [&](const auto &changed) {
+                         return changed.tree == tree &&
+                                changed.property == property;
+                     }) != changedProperties.end();
+
+    if (!alreadyChanged)
+        changedProperties.push_back({tree, property, getPath(tree)});
+}
+
+void EditJournal::valueTreeChildAdded(juce::ValueTree &parentTree,
+                                      juce::ValueTree &childWhichHasBeenAdded) {
+    writeChangedProperties();
+    writeRecord(Operation::addChild, getPath(parentTree),
+                [&](juce::OutputStream &output) {
+                    output.writeCompressedInt(
+                        parentTree.indexOf(childWhichHasBeenAdded));
+                    childWhichHasBeenAdded.writeToStream(output);
+                });
+}
+
+void EditJournal::valueTreeChildRemoved(juce::ValueTree &parentTree,
+                                        juce::ValueTree &,
+                                        int indexFromWhichChildWasRemoved) {
+    writeChangedProperties();
+    writeRecord(Operation::removeChild, getPath(parentTree),
+                [&](juce::OutputStream &output) {
+                    output.writeCompressedInt(indexFromWhichChildWasRemoved);
+                });
+}
+
+void EditJournal::valueTreeChildOrderChanged(juce::ValueTree &parentTree,
+                                             int oldIndex, int newIndex) {
+    writeChangedProperties();
+    writeRecord(Operation::moveChild, getPath(parentTree),
+                [&](juce::OutputStream &output) {
+                    output.writeCompressedInt(oldIndex);
+                    output.writeCompressedInt(newIndex);
+                });
+}
+
+void EditJournal::editSaved(const juce::File &destination, bool success) {
+    // the journal header refers to the project file that has been replaced
+    if (success && destination == projectFile)
+        compact();
+}
+
+void EditJournal::timerCallback() {
+    flush();
+
+    if (journalSize > maxJournalSize)
+        compact();
+}
+
+void EditJournal::run() {
+    while (!threadShouldExit()) {
+        wait(-1);
+        writePendingTasks();
+    }
+
+    writePendingTasks();
+}
+
+void EditJournal::writeChangedProperties() {
+    // written before the structural change which flushes them, at the paths
+    // the trees had when their properties changed
+    for (const auto &[tree, property, path] : changedProperties) {
+        if (auto value = tree.getPropertyPointer(property)) {
+            writeRecord(Operation::setProperty, path,
+                        [&](juce::OutputStream &output) {
+                            output.writeString(property.toString());
+                            value->writeToStream(output);
+                        });
+        } else {
+            writeRecord(Operation::removeProperty, path,
+                        [&](juce::OutputStream &output) {
+                            output.writeString(property.toString());
+                        });
+        }
+    }
+
+    changedProperties.clear();
+}
+
+void EditJournal::writeRecord(
+    Operation operation, const juce::Array<int> &path,
+    const std::function<void(juce::OutputStream &)> &body) {
+    juce::MemoryOutputStream record;
+    record.writeByte(static_cast<char>(operation));
+
+    record.writeCompressedInt(path.size());
+    for (auto index : path)
+        record.writeCompressedInt(index);
+
+    body(record);
+
+    records.writeCompressedInt(int(record.getDataSize()));
+    records << record;
+}
+
+void EditJournal::addTask(WriteTask task) {
+    {
+        const juce::ScopedLock lock(tasksLock);
+        pendingTasks.push_back(std::move(task));
+    }
+
+    notify();
+}
+
+void EditJournal::writePendingTasks() {
+    std::vector<WriteTask> tasks;
+
+    {
+        const juce::ScopedLock lock(tasksLock);
+        tasks.swap(pendingTasks);
+    }
+
+    for (const auto &task : tasks) {
+        if (task.snapshot.isValid())
+            writeSnapshot(task);
+
+        if (task.records.isEmpty() || !ownsJournalFile())
+            continue;
+
+        juce::FileOutputStream output(journalFile);
+        if (!output.openedOk()) {
+            AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                                   "Error opening journal: " +
+                                       journalFile.getFullPathName());
+            continue;
+        }
+
+        output.write(task.records.getData(), task.records.getSize());
+        // also syncs the file to the disk
+        output.flush();
+    }
+}
+
+bool EditJournal::ownsJournalFile() const {
+    juce::FileInputStream input(journalFile);
+    if (!input.openedOk() || input.readInt() != magicNumber)
+        return false;
+
+    input.readInt64(); // project modification time
+    return input.readInt64() == sessionID;
+}
+
+void EditJournal::writeSnapshot(const WriteTask &task) const {
+    juce::TemporaryFile temporaryFile(journalFile,
+                                      juce::TemporaryFile::useHiddenFile);
+
+    {
+        juce::FileOutputStream output(temporaryFile.getFile());
+        if (!output.openedOk()) {
+            AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                                   "Error writing journal: " +
+                                       journalFile.getFullPathName());
+            return;
+        }
+
+        output.writeInt(magicNumber);
+        output.writeInt64(task.projectModificationTime);
+        output.writeInt64(sessionID);
+        task.snapshot.writeToStream(output);
+        output.flush();
+    }
+
+    if (!temporaryFile.overwriteTargetFileWithTemporary())
+        AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                               "Error writing journal: " +
+                                   journalFile.getFullPathName());
+}
+
+juce::Array<int> EditJournal::getPath(const juce::ValueTree &tree) {
+    juce::Array<int> path;
+
+    for (auto child = tree, parent = tree.getParent(); parent.isValid();
+         child = parent, parent = parent.getParent())
+        path.insert(0, parent.indexOf(child));
+
+    return path;
+}
+
+bool EditJournal::applyRecord(juce::ValueTree &root,
+                              juce::InputStream &input) {
+    auto operation = static_cast<Operation>(input.readByte());
+
+    auto tree = root;
+    auto depth = input.readCompressedInt();
+    for (int i = 0; i < depth; ++i) {
+        tree = tree.getChild(input.readCompressedInt());
+        if (!tree.isValid())
+            return false;
+    }
+
+    switch (operation) {
+    case Operation::setProperty:
+    case Operation::removeProperty: {
+        auto name = input.readString();
+        if (name.isEmpty())
+            return false;
+
+        if (operation == Operation::removeProperty)
+            tree.removeProperty(name, nullptr);
+        else
+            tree.setProperty(name, juce::var::readFromStream(input), nullptr);
+
+        return true;
+    }
+    case Operation::addChild: {
+        auto index = input.readCompressedInt();
+        auto child = juce::ValueTree::readFromStream(input);
+        if (!child.isValid())
+            return false;
+
+        tree.addChild(child, index, nullptr);
+        return true;
+    }
+    case Operation::removeChild: {
+        auto index = input.readCompressedInt();
+        if (!juce::isPositiveAndBelow(index, tree.getNumChildren()))
+            return false;
+
+        tree.removeChild(index, nullptr);
+        return true;
+    }
+    case Operation::moveChild: {
+        auto oldIndex = input.readCompressedInt();
+        auto newIndex = input.readCompressedInt();
+        if (!juce::isPositiveAndBelow(oldIndex, tree.getNumChildren()) ||
+            !juce::isPositiveAndBelow(newIndex, tree.getNumChildren()))
+            return false;
+
+        tree.moveChild(oldIndex, newIndex, nullptr);
+        return true;
+    }
+    }
+
+    return false;
+}
+
+} // namespace app_services
@@ -0,0 +1,113 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Records every change of an edit state to a journal file next to the
+ * project, so unsaved changes can be recovered after a crash.
+ * The journal starts with a snapshot of the state followed by the changes
+ * made since, in a compact binary form. Changes are appended from a
+ * background thread about once a second and the journal is rewritten with
+ * a new snapshot when it grows too large or the project is saved.
+ */
+class EditJournal : private juce::ValueTree::Listener,
+                    private EditSaveService::Listener,
+                    private juce::Timer,
+                    private juce::Thread {
+  public:
+    EditJournal(tracktion::Edit &e, const juce::File &file);
+    ~EditJournal() override;
+
+    static juce::File getJournalFile(const juce::File &projectFile);
+
+    /**
+     * Return the state stored in the journal of a project with its changes
+     * replayed, or an invalid tree if there is no journal or the project file
+     * has been replaced since the journal was written
+     */
+    static juce::ValueTree recover(const juce::File &projectFile);
+
+    /**
+     * Send the changes recorded since the last flush to the writer thread
+     */
+    void flush();
+    /**
+     * Replace the journal content with a snapshot of the current state
+     */
+    void compact();
+
+    static constexpr int flushIntervalMs = 1000;
+    static constexpr juce::int64 maxJournalSize = 256 * 1024;
+
+  private:
+    enum class Operation : juce::uint8 {
+        setProperty = 1,
+        removeProperty,
+        addChild,
+        removeChild,
+        moveChild
+    };
+
+    tracktion::Edit &edit;
+    juce::File projectFile;
+    juce::File journalFile;
+    // identifies the journal written by this instance, an instance started
+    // while this one is quitting takes the file over
+    const juce::int64 sessionID = juce::Random::getSystemRandom().nextInt64();
+    juce::SharedResourcePointer<EditSaveService> saveService;
+
+    // written on the message thread, handed to the writer on flush
+    juce::MemoryOutputStream records;
+    struct ChangedProperty {
+        juce::ValueTree tree;
+        juce::Identifier property;
+        // taken when the property changed, a structural change flushes the
+        // properties after it has moved the trees
+        juce::Array<int> path;
+    };
+
+    // properties changed since the last flush, their values are read when
+    // flushing so repeated changes are recorded once
+    std::vector<ChangedProperty> changedProperties;
+    juce::int64 journalSize = 0;
+
+    struct WriteTask {
+        juce::ValueTree snapshot;
+        juce::int64 projectModificationTime = 0;
+        juce::MemoryBlock records;
+    };
+
+    juce::CriticalSection tasksLock;
+    std::vector<WriteTask> pendingTasks;
+
+    void valueTreePropertyChanged(juce::ValueTree &tree,
+                                  const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parentTree,
+                             juce::ValueTree &childWhichHasBeenAdded) override;
+    void valueTreeChildRemoved(juce::ValueTree &parentTree,
+                               juce::ValueTree &childWhichHasBeenRemoved,
+                               int indexFromWhichChildWasRemoved) override;
+    void valueTreeChildOrderChanged(juce::ValueTree &parentTree,
+                                    int oldIndex, int newIndex) override;
+
+    void editSaved(const juce::File &destination, bool success) override;
+
+    void timerCallback() override;
+    void run() override;
+
+    void writeChangedProperties();
+    void writeRecord(Operation operation, const juce::Array<int> &path,
+                     const std::function<void(juce::OutputStream &)> &body);
+    void addTask(WriteTask task);
+    void writePendingTasks();
+    bool ownsJournalFile() const;
+    void writeSnapshot(const WriteTask &task) const;
+
+    static juce::Array<int> getPath(const juce::ValueTree &tree);
+    static bool applyRecord(juce::ValueTree &root, juce::InputStream &input);
+
+    static constexpr int magicNumber = 0x4a4e4d4c; // "LMNJ"
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditJournal)
+};
+
+} // namespace app_services
@@ -0,0 +1,112 @@
+#include "EditRenderService.h"
+
+namespace app_services {
+
+EditRenderService::EditRenderService(tracktion::Edit &e) : edit(e) {}
+
+EditRenderService::~EditRenderService() {
+    stopTimer();
+
+    if (task != nullptr) {
+        task->signalJobShouldExit();
+        threadPool.removeAllJobs(true, 10000);
+        destinationFile.deleteFile();
+    }
+}
+
+bool EditRenderService::startRender(const juce::File &destination) {
+    if (isRendering())
+        return false;
+
+    edit.getTransport().stop(false, false);
+
+    tracktion::Renderer::Parameters parameters(edit);
+    parameters.destFile = destination;
+    parameters.audioFormat =
+        edit.engine.getAudioFileFormatManager().getWavFormat();
+    parameters.bitDepth = 24;
+    parameters.sampleRateForAudio =
+        edit.engine.getDeviceManager().getSampleRate();
+    parameters.blockSizeForAudio =
+        edit.engine.getDeviceManager().getBlockSize();
+    parameters.time = tracktion::TimeRange(
+        tracktion::TimePosition::fromSeconds(0.0), edit.getLength());
+    parameters.usePlugins = true;
+    parameters.useMasterPlugins = true;
+
+    juce::BigInteger tracksToDo{0};
+    for (auto i = 0; i < tracktion::getAllTracks(edit).size(); i++)
+        tracksToDo.setBit(i);
+
+    parameters.tracksToDo = tracksToDo;
+
+    destination.getParentDirectory().createDirectory();
+    destinationFile = destination;
+    wasCancelled = false;
+
+    // frees the playback graph until the render is finished
+    renderStatus =
+        std::make_unique<tracktion::Edit::ScopedRenderStatus>(edit, true);
+    task = std::make_unique<tracktion::Renderer::RenderTask>(
+        "Render", parameters, nullptr, nullptr);
+    threadPool.addJob(task.get(), false);
+
+    startTimerHz(progressRefreshRate);
+    listeners.call([this](Listener &l) { l.renderStarted(destinationFile); });
+    return true;
+}
+
+void EditRenderService::cancelRender() {
+    if (!isRendering())
+        return;
+
+    wasCancelled = true;
+    task->signalJobShouldExit();
+}
+
+float EditRenderService::getProgress() const {
+    if (task == nullptr)
+        return 0.0f;
+
+    return juce::jlimit(0.0f, 1.0f, task->getCurrentTaskProgress());
+}
+
+void EditRenderService::timerCallback() {
+    if (threadPool.contains(task.get())) {
+        auto progress = getProgress();
+        listeners.call(
+            [progress](Listener &l) { l.renderProgressChanged(progress); });
+        return;
+    }
+
+    finishRender();
+}
+
+void EditRenderService::finishRender() {
+    stopTimer();
+
+    auto result = Result::completed;
+    if (wasCancelled) {
+        result = Result::cancelled;
+    } else if (task->errorMessage.isNotEmpty()) {
+        AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                               "Render failed: " + task->errorMessage);
+        result = Result::failed;
+    }
+
+    task = nullptr;
+    renderStatus = nullptr;
+
+    if (result != Result::completed)
+        destinationFile.deleteFile();
+
+    listeners.call([this, result](Listener &l) {
+        l.renderFinished(destinationFile, result);
+    });
+}
+
+void EditRenderService::addListener(Listener *l) { listeners.add(l); }
+
+void EditRenderService::removeListener(Listener *l) { listeners.remove(l); }
+
+} // namespace app_services
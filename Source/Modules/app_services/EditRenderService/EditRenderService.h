@@ -0,0 +1,62 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Renders an edit to a file on a background thread.
+ * Listeners are called on the message thread while the render runs, the
+ * edit can be navigated but not played until the render finishes.
+ */
+class EditRenderService : private juce::Timer {
+  public:
+    explicit EditRenderService(tracktion::Edit &e);
+    ~EditRenderService() override;
+
+    /**
+     * Start rendering every track of the edit to a wav file.
+     * Returns false if a render is already running.
+     */
+    bool startRender(const juce::File &destination);
+    /**
+     * Stop the current render, the partially rendered file is deleted
+     */
+    void cancelRender();
+    bool isRendering() const { return task != nullptr; }
+
+    /**
+     * Progress of the current render between 0 & 1
+     */
+    float getProgress() const;
+
+    enum class Result { completed, cancelled, failed };
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void renderStarted(const juce::File & /*destination*/) {}
+        virtual void renderProgressChanged(float /*progress*/) {}
+        virtual void renderFinished(const juce::File & /*destination*/,
+                                    Result /*result*/) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    tracktion::Edit &edit;
+    juce::ThreadPool threadPool{1};
+    std::unique_ptr<tracktion::Edit::ScopedRenderStatus> renderStatus;
+    std::unique_ptr<tracktion::Renderer::RenderTask> task;
+    juce::File destinationFile;
+    bool wasCancelled = false;
+
+    juce::ListenerList<Listener> listeners;
+
+    static constexpr int progressRefreshRate = 10;
+    void timerCallback() override;
+    void finishRender();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditRenderService)
+};
+
+} // namespace app_services
@@ -0,0 +1,242 @@
+#include "EditSaveService.h"
+
+#if JUCE_LINUX || JUCE_MAC
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace app_services {
+
+// counts the changes made to an edit, so comparing two counts tells whether
+// it has been changed in between without comparing its trees
+class EditSaveService::ChangeCounter : private juce::ValueTree::Listener {
+  public:
+    explicit ChangeCounter(tracktion::Edit &e) : edit(&e), state(e.state) {
+        state.addListener(this);
+    }
+
+    ~ChangeCounter() override { state.removeListener(this); }
+
+    tracktion::Edit *getEdit() const { return edit.get(); }
+    juce::uint64 getCount() const { return count; }
+
+  private:
+    juce::WeakReference<tracktion::Edit> edit;
+    juce::ValueTree state;
+    juce::uint64 count = 0;
+
+    void valueTreePropertyChanged(juce::ValueTree &,
+                                  const juce::Identifier &) override {
+        ++count;
+    }
+
+    void valueTreeChildAdded(juce::ValueTree &, juce::ValueTree &) override {
+        ++count;
+    }
+
+    void valueTreeChildRemoved(juce::ValueTree &, juce::ValueTree &,
+                               int) override {
+        ++count;
+    }
+
+    void valueTreeChildOrderChanged(juce::ValueTree &, int, int) override {
+        ++count;
+    }
+};
+
+EditSaveService::EditSaveService() : juce::Thread("Edit saver") {
+    requestsWritten.signal();
+    startThread();
+}
+
+EditSaveService::~EditSaveService() {
+    // the thread writes the remaining requests before exiting
+    stopThread(10000);
+    cancelPendingUpdate();
+}
+
+void EditSaveService::requestSave(tracktion::Edit &edit) {
+    tracktion::EditFileOperations fileOperations(edit);
+    requestSave(edit, {fileOperations.getEditFile()});
+}
+
+void EditSaveService::requestSave(tracktion::Edit &edit,
+                                  const juce::Array<juce::File> &destinations) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // plugins write their state to the tree when flushed
+    edit.flushState();
+    addRequest({edit.state.createCopy(), destinations, &edit,
+                tracktion::EditFileOperations(edit).getEditFile(),
+                getChangeCounter(edit).getCount()});
+}
+
+void EditSaveService::requestWrite(const juce::ValueTree &state,
+                                   const juce::File &destination) {
+    addRequest({state, {destination}});
+}
+
+void EditSaveService::addRequest(SaveRequest request) {
+    {
+        const juce::ScopedLock lock(requestsLock);
+
+        // this snapshot is newer than the pending ones
+        for (auto &pending : pendingRequests)
+            for (const auto &destination : request.destinations)
+                pending.destinations.removeAllInstancesOf(destination);
+
+        pendingRequests.erase(
+            std::remove_if(pendingRequests.begin(), pendingRequests.end(),
+                           [](const SaveRequest &pending) {
+                               return pending.destinations.isEmpty();
+                           }),
+            pendingRequests.end());
+
+        pendingRequests.push_back(std::move(request));
+        requestsWritten.reset();
+    }
+
+    notify();
+}
+
+bool EditSaveService::waitForPendingSaves(int timeoutMs) {
+    return requestsWritten.wait(double(timeoutMs));
+}
+
+void EditSaveService::run() {
+    while (!threadShouldExit()) {
+        wait(-1);
+        writePendingRequests();
+    }
+
+    writePendingRequests();
+}
+
+void EditSaveService::writePendingRequests() {
+    for (;;) {
+        SaveRequest request;
+
+        {
+            const juce::ScopedLock lock(requestsLock);
+
+            if (pendingRequests.empty()) {
+                requestsWritten.signal();
+                return;
+            }
+
+            request = std::move(pendingRequests.front());
+            pendingRequests.erase(pendingRequests.begin());
+        }
+
+        for (const auto &destination : request.destinations) {
+            auto directoryTime =
+                destination.getParentDirectory().getLastModificationTime();
+            auto success = writeAtomically(request.snapshot, destination);
+            if (success)
+                ProjectIndex::update(destination, request.snapshot,
+                                     directoryTime);
+            else
+                AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                                       "Error saving edit to: " +
+                                           destination.getFullPathName());
+
+            SaveResult result{destination, success};
+            if (destination == request.editFile) {
+                result.edit = request.edit;
+                result.changeCount = request.changeCount;
+            }
+
+            const juce::ScopedLock lock(resultsLock);
+            results.push_back(std::move(result));
+        }
+
+        triggerAsyncUpdate();
+    }
+}
+
+bool EditSaveService::writeAtomically(const juce::ValueTree &state,
+                                      const juce::File &destination) {
+    auto directory = destination.getParentDirectory();
+    if (!directory.createDirectory())
+        return false;
+
+    juce::TemporaryFile temporaryFile(destination,
+                                      juce::TemporaryFile::useHiddenFile);
+
+    {
+        juce::FileOutputStream output(temporaryFile.getFile());
+        if (!output.openedOk())
+            return false;
+
+        if (!ProjectFile::write(state, output,
+                                ProjectFile::getFormatForFile(destination)))
+            return false;
+
+        // also syncs the file to the disk
+        output.flush();
+        if (output.getStatus().failed())
+            return false;
+    }
+
+    if (!temporaryFile.overwriteTargetFileWithTemporary())
+        return false;
+
+#if JUCE_LINUX || JUCE_MAC
+    // make the rename itself durable
+    auto directoryDescriptor =
+        open(directory.getFullPathName().toRawUTF8(), O_RDONLY);
+    if (directoryDescriptor >= 0) {
+        fsync(directoryDescriptor);
+        close(directoryDescriptor);
+    }
+#endif
+
+    return true;
+}
+
+void EditSaveService::handleAsyncUpdate() {
+    std::vector<SaveResult> writtenResults;
+
+    {
+        const juce::ScopedLock lock(resultsLock);
+        writtenResults.swap(results);
+    }
+
+    for (const auto &result : writtenResults) {
+        // a failed write leaves the edit unsaved, and so do the changes made
+        // while the snapshot was written
+        if (auto *edit = result.edit.get())
+            if (result.success &&
+                getChangeCounter(*edit).getCount() == result.changeCount)
+                edit->resetChangedStatus();
+
+        listeners.call([&result](Listener &l) {
+            l.editSaved(result.destination, result.success);
+        });
+    }
+}
+
+EditSaveService::ChangeCounter &
+EditSaveService::getChangeCounter(tracktion::Edit &edit) {
+    // the counters of the edits which have been deleted
+    changeCounters.erase(std::remove_if(changeCounters.begin(),
+                                        changeCounters.end(),
+                                        [](const auto &counter) {
+                                            return counter->getEdit() ==
+                                                   nullptr;
+                                        }),
+                         changeCounters.end());
+
+    for (auto &counter : changeCounters)
+        if (counter->getEdit() == &edit)
+            return *counter;
+
+    changeCounters.push_back(std::make_unique<ChangeCounter>(edit));
+    return *changeCounters.back();
+}
+
+void EditSaveService::addListener(Listener *l) { listeners.add(l); }
+
+void EditSaveService::removeListener(Listener *l) { listeners.remove(l); }
+
+} // namespace app_services
@@ -0,0 +1,104 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Saves edits from a background thread.
+ * The edit state is copied on the message thread when a save is requested,
+ * then written to a temporary file which is synced to disk and renamed over
+ * the destination, so an interrupted save never leaves a truncated file.
+ * Requests for a destination that hasn't been written yet replace the
+ * pending one. The edit is marked as saved once its own file has been
+ * written, unless it has been changed since the request.
+ *
+ * Use it through `juce::SharedResourcePointer<EditSaveService>`, pending
+ * saves are written before the last pointer is released.
+ */
+class EditSaveService : private juce::Thread, private juce::AsyncUpdater {
+  public:
+    EditSaveService();
+    ~EditSaveService() override;
+
+    /**
+     * Save the edit to its own file
+     */
+    void requestSave(tracktion::Edit &edit);
+    /**
+     * Save the same snapshot of the edit to every destination
+     */
+    void requestSave(tracktion::Edit &edit,
+                     const juce::Array<juce::File> &destinations);
+    /**
+     * Write a tree that isn't an edit, like an index, from the save thread
+     */
+    void requestWrite(const juce::ValueTree &state,
+                      const juce::File &destination);
+
+    /**
+     * Block until every pending save has been written, returns false on
+     * timeout
+     */
+    bool waitForPendingSaves(int timeoutMs = -1);
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called on the message thread once a destination has been written
+         */
+        virtual void editSaved(const juce::File & /*destination*/,
+                               bool /*success*/) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+    /**
+     * Write the tree to the file through a synced temporary file, in the
+     * format matching the file extension (see ProjectFile)
+     */
+    static bool writeAtomically(const juce::ValueTree &state,
+                                const juce::File &destination);
+
+  private:
+    class ChangeCounter;
+
+    struct SaveRequest {
+        juce::ValueTree snapshot;
+        juce::Array<juce::File> destinations;
+        juce::WeakReference<tracktion::Edit> edit;
+        juce::File editFile;
+        // changes of the edit counted when the snapshot was taken
+        juce::uint64 changeCount = 0;
+    };
+
+    struct SaveResult {
+        juce::File destination;
+        bool success;
+        // set when the destination is the file of the edit
+        juce::WeakReference<tracktion::Edit> edit;
+        juce::uint64 changeCount = 0;
+    };
+
+    juce::CriticalSection requestsLock;
+    std::vector<SaveRequest> pendingRequests;
+    juce::WaitableEvent requestsWritten{true};
+
+    juce::CriticalSection resultsLock;
+    std::vector<SaveResult> results;
+
+    juce::ListenerList<Listener> listeners;
+
+    // only used on the message thread
+    std::vector<std::unique_ptr<ChangeCounter>> changeCounters;
+
+    ChangeCounter &getChangeCounter(tracktion::Edit &edit);
+    void addRequest(SaveRequest request);
+    void run() override;
+    void writePendingRequests();
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditSaveService)
+};
+
+} // namespace app_services
@@ -0,0 +1,69 @@
+#include "FrameScheduler.h"
+
+namespace app_services {
+
+FrameScheduler::~FrameScheduler() { stopTimer(); }
+
+void FrameScheduler::addClient(Client *client, juce::Component *component,
+                               int divisor) {
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(client != nullptr && divisor > 0);
+
+    removeClient(client);
+
+    divisor = juce::jmax(1, divisor);
+    subscriptions.push_back({client, component, component != nullptr, divisor,
+                             nextPhase++ % divisor});
+
+    if (!isTimerRunning())
+        startTimerHz(frameRate);
+}
+
+void FrameScheduler::removeClient(Client *client) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    for (auto &subscription : subscriptions)
+        if (subscription.client == client)
+            subscription.client = nullptr;
+
+    // a client removed by a callback is erased after the frame
+    if (!isCallingClients)
+        eraseRemovedClients();
+}
+
+void FrameScheduler::timerCallback() {
+    ++frameCount;
+    isCallingClients = true;
+
+    // clients added by a callback are appended and called on this frame
+    for (size_t i = 0; i < subscriptions.size(); ++i) {
+        auto subscription = subscriptions[i];
+        if (subscription.client == nullptr ||
+            (frameCount + juce::uint32(subscription.phase)) %
+                    juce::uint32(subscription.divisor) !=
+                0)
+            continue;
+
+        if (subscription.hasComponent &&
+            (subscription.component == nullptr ||
+             !subscription.component->isShowing()))
+            continue;
+
+        subscription.client->frameCallback();
+    }
+
+    isCallingClients = false;
+    eraseRemovedClients();
+}
+
+void FrameScheduler::eraseRemovedClients() {
+    subscriptions.erase(
+        std::remove_if(subscriptions.begin(), subscriptions.end(),
+                       [](const auto &s) { return s.client == nullptr; }),
+        subscriptions.end());
+
+    if (subscriptions.empty())
+        stopTimer();
+}
+
+} // namespace app_services
@@ -0,0 +1,56 @@
+#pragma once
+namespace app_services {
+
+/**
+ * One clock for every animated component of the app.
+ * Clients are called on the message thread every frame, or every few frames
+ * with a divisor, from a single timer which only runs while there are
+ * clients. A client attached to a component isn't called while the
+ * component isn't showing. Clients with the same divisor are spread across
+ * frames so they don't all update on the same one.
+ *
+ * Use it through `juce::SharedResourcePointer<FrameScheduler>`.
+ */
+class FrameScheduler : private juce::Timer {
+  public:
+    class Client {
+      public:
+        virtual ~Client() = default;
+
+        virtual void frameCallback() = 0;
+    };
+
+    FrameScheduler() = default;
+    ~FrameScheduler() override;
+
+    /**
+     * Call the client every `divisor` frames, while the component is showing
+     * if there is one
+     */
+    void addClient(Client *client, juce::Component *component = nullptr,
+                   int divisor = 1);
+    void removeClient(Client *client);
+
+    static constexpr int frameRate = 60;
+
+  private:
+    struct Subscription {
+        Client *client;
+        juce::Component::SafePointer<juce::Component> component;
+        bool hasComponent;
+        int divisor;
+        int phase;
+    };
+
+    std::vector<Subscription> subscriptions;
+    juce::uint32 frameCount = 0;
+    int nextPhase = 0;
+    bool isCallingClients = false;
+
+    void timerCallback() override;
+    void eraseRemovedClients();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameScheduler)
+};
+
+} // namespace app_services
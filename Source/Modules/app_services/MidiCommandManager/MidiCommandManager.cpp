@@ -2,6 +2,48 @@
 #include <typeinfo>
 namespace app_services {
 
+struct CommandMapping {
+    MidiCommandManager::Command command;
+    const char *name;
+    int defaultControllerNumber;
+};
+
+using Command = MidiCommandManager::Command;
+
+// LMN-3 control surface layout
+static const CommandMapping commandMappings[] = {
+    {Command::encoder1, "encoder-1", 3},
+    {Command::encoder2, "encoder-2", 9},
+    {Command::encoder3, "encoder-3", 14},
+    {Command::encoder4, "encoder-4", 15},
+    {Command::encoder1Button, "encoder-1-button", 20},
+    {Command::encoder2Button, "encoder-2-button", 21},
+    {Command::encoder3Button, "encoder-3-button", 22},
+    {Command::encoder4Button, "encoder-4-button", 23},
+    {Command::undo, "undo", 24},
+    {Command::tempoSettings, "tempo", 25},
+    {Command::save, "save", 26},
+    {Command::settings, "settings", 85},
+    {Command::tracks, "tracks", 86},
+    {Command::mixer, "mixer", 88},
+    {Command::plugins, "plugins", 89},
+    {Command::modifiers, "modifiers", 90},
+    {Command::sequencers, "sequencers", 102},
+    {Command::loopIn, "loop-in", 103},
+    {Command::loopOut, "loop-out", 104},
+    {Command::loop, "loop", 105},
+    {Command::cut, "cut", 106},
+    {Command::paste, "paste", 107},
+    {Command::slice, "slice", 108},
+    {Command::record, "record", 109},
+    {Command::play, "play", 110},
+    {Command::stop, "stop", 111},
+    {Command::control, "control", 112},
+    {Command::octave, "octave", 117},
+    {Command::plus, "plus", 118},
+    {Command::minus, "minus", 119},
+};
+
 MidiCommandManager::MidiCommandManager(tracktion::Engine &e) : engine(e) {
     // need  to listen to midi events to pass to the midi command manager
     // to do this we need to call the addMidiInputDeviceCallback method
@@ -20,6 +62,12 @@ MidiCommandManager::MidiCommandManager(tracktion::Engine &e) : engine(e) {
         juceDeviceManager.addMidiInputDeviceCallback(midiDevice.identifier,
                                                      this);
     }
+
+    resetControllerMapping();
+
+    // parameter encoders can be turned 4 times faster during a sweep
+    for (int encoder = 1; encoder <= 4; encoder++)
+        encoderAccelerations[size_t(encoder)].maxMultiplier = 4.0;
 }
 
 MidiCommandManager::~MidiCommandManager() {
@@ -29,11 +77,14 @@ MidiCommandManager::~MidiCommandManager() {
         juceDeviceManager.removeMidiInputDeviceCallback(midiDevice.identifier,
                                                         this);
     }
+
+    cancelPendingUpdate();
 }
 
 void MidiCommandManager::setFocusedComponent(juce::Component *c) {
     jassert(c != nullptr);
     focusedComponent = c;
+    focusedListener = dynamic_cast<Listener *>(c);
 }
 
 juce::Component *MidiCommandManager::getFocusedComponent() {
@@ -41,389 +92,433 @@ juce::Component *MidiCommandManager::getFocusedComponent() {
 }
 
 void MidiCommandManager::handleIncomingMidiMessage(
-    juce::MidiInput *source, const juce::MidiMessage &message) {
-    (new IncomingMessageCallback(*this, message, source->getName()))->post();
-}
+    juce::MidiInput * /*source*/, const juce::MidiMessage &message) {
+    // the control surface only sends short messages
+    if (message.getRawDataSize() > 3)
+        return;
 
-void MidiCommandManager::midiMessageReceived(const juce::MidiMessage &message,
-                                             const juce::String & /*source*/) {
-    juce::Logger::writeToLog(getMidiMessageDescription(message));
+    {
+        const juce::SpinLock::ScopedLockType lock(incomingWriteLock);
 
-    if (message.isNoteOn()) {
-        if (auto listener = dynamic_cast<Listener *>(focusedComponent))
-            listener->noteOnPressed(message.getNoteNumber());
-    }
+        if (incomingFifo.getFreeSpace() == 0) {
+            numDroppedMessages++;
+            return;
+        }
 
-    if (message.isController()) {
-        listeners.call([message](Listener &l) {
-            l.controllerEventReceived(message.getControllerNumber(),
-                                      message.getControllerValue());
+        incomingFifo.write(1).forEach([&](int index) {
+            auto &incoming = incomingMessages[size_t(index)];
+            incoming.size = message.getRawDataSize();
+            std::memcpy(incoming.data, message.getRawData(),
+                        size_t(incoming.size));
         });
+    }
 
-        switch (message.getControllerNumber()) {
-        case ENCODER_1:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder1Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder1Decreased();
-            }
-
-            break;
-
-        case ENCODER_2:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder2Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder2Decreased();
-            }
-
-            break;
-
-        case ENCODER_3:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder3Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder3Decreased();
-            }
-
-            break;
-
-        case ENCODER_4:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 1)
-                    listener->encoder4Increased();
-
-                if (message.getControllerValue() == 127)
-                    listener->encoder4Decreased();
-            }
-
-            break;
-
-        case ENCODER_1_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder1ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder1ButtonReleased();
-            }
-
-            break;
-
-        case ENCODER_2_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder2ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder2ButtonReleased();
-            }
-
-            break;
-
-        case ENCODER_3_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder3ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder3ButtonReleased();
-            }
-
-            break;
-
-        case ENCODER_4_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->encoder4ButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->encoder4ButtonReleased();
-            }
-
-            break;
-
-        case TRACKS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.tracksButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.tracksButtonReleased(); });
-
-            break;
-
-        case MIXER_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.mixerButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.mixerButtonReleased(); });
-
-            break;
-
-        case PLUGINS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.pluginsButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.pluginsButtonReleased(); });
-
-            break;
-
-        case MODIFIERS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.modifiersButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call(
-                    [](Listener &l) { l.modifiersButtonReleased(); });
-
-            break;
-
-        case SETTINGS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.settingsButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.settingsButtonReleased(); });
-
-            break;
-
-        case TEMPO_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call(
-                    [](Listener &l) { l.tempoSettingsButtonPressed(); });
-
-            if (message.getControllerValue() == 0)
-                listeners.call(
-                    [](Listener &l) { l.tempoSettingsButtonReleased(); });
-
-            break;
-
-        case SAVE_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-
-            if (isControlDown) {
-                if (message.getControllerValue() == 127)
-                    listeners.call(
-                        [](Listener &l) { l.renderButtonPressed(); });
-
-                if (message.getControllerValue() == 0)
-                    listeners.call(
-                        [](Listener &l) { l.renderButtonReleased(); });
-            } else {
-                if (message.getControllerValue() == 127)
-                    listeners.call([](Listener &l) { l.saveButtonPressed(); });
-
-                if (message.getControllerValue() == 0)
-                    listeners.call([](Listener &l) { l.saveButtonReleased(); });
-            }
-
-            break;
-
-        case RECORD_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->recordButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->recordButtonReleased();
-            }
-
-            break;
-
-        case PLAY_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->playButtonPressed();
-
-                if (message.getControllerValue() == 0)
-                    listener->playButtonReleased();
-            }
+    // only posts a message if the previous batch has been handled
+    triggerAsyncUpdate();
+}
 
-            break;
+void MidiCommandManager::handleAsyncUpdate() {
+    if (auto dropped = numDroppedMessages.exchange(0))
+        AsyncFileLogger::write(AsyncFileLogger::Level::warning,
+                               "Dropped " + juce::String(dropped) +
+                                   " midi messages");
+
+    // consecutive ticks of the same encoder are sent as a single move
+    int pendingEncoder = 0;
+    int pendingDelta = 0;
+    auto flushEncoderMove = [&]() {
+        if (pendingDelta != 0)
+            dispatchEncoderMove(pendingEncoder, pendingDelta);
+
+        pendingEncoder = 0;
+        pendingDelta = 0;
+    };
+
+    while (incomingFifo.getNumReady() > 0) {
+        IncomingMessage incoming{};
+        incomingFifo.read(1).forEach([&](int index) {
+            incoming = incomingMessages[size_t(index)];
+        });
 
-        case STOP_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->stopButtonPressed();
+        juce::MidiMessage message(incoming.data, incoming.size);
 
-                if (message.getControllerValue() == 0)
-                    listener->stopButtonReleased();
-            }
+        if (auto tick = getEncoderTick(message)) {
+            if (logVerbosity == LogVerbosity::all)
+                AsyncFileLogger::write(AsyncFileLogger::Level::debug,
+                                       getMidiMessageDescription(message));
 
-            break;
-
-        case SEQUENCERS_BUTTON:
-            // This should be called for all listeners, not just the currently
-            // focused component
-            if (message.getControllerValue() == 127)
-                listeners.call(
-                    [](Listener &l) { l.sequencersButtonPressed(); });
+            listeners.call([message](Listener &l) {
+                l.controllerEventReceived(message.getControllerNumber(),
+                                          message.getControllerValue());
+            });
 
-            if (message.getControllerValue() == 0)
-                listeners.call(
-                    [](Listener &l) { l.sequencersButtonReleased(); });
+            auto encoder =
+                getEncoderNumber(getCommand(message.getControllerNumber()));
+            if (encoder != pendingEncoder)
+                flushEncoderMove();
 
-            break;
+            pendingEncoder = encoder;
+            pendingDelta += tick;
+        } else {
+            flushEncoderMove();
+            midiMessageReceived(message, {});
+        }
+    }
 
-        case CUT_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->cutButtonPressed();
+    flushEncoderMove();
+}
 
-                if (message.getControllerValue() == 0)
-                    listener->cutButtonReleased();
-            }
+void MidiCommandManager::mapController(Command command, int controllerNumber) {
+    jassert(juce::isPositiveAndBelow(controllerNumber, numControllers));
+    if (!juce::isPositiveAndBelow(controllerNumber, numControllers))
+        return;
 
-            break;
+    if (command != Command::none)
+        std::replace(controllerCommands.begin(), controllerCommands.end(),
+                     command, Command::none);
 
-        case PASTE_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->pasteButtonPressed();
+    controllerCommands[size_t(controllerNumber)] = command;
+}
 
-                if (message.getControllerValue() == 0)
-                    listener->pasteButtonReleased();
-            }
+void MidiCommandManager::resetControllerMapping() {
+    controllerCommands.fill(Command::none);
 
-            break;
+    for (const auto &mapping : commandMappings)
+        controllerCommands[size_t(mapping.defaultControllerNumber)] =
+            mapping.command;
+}
 
-        case SLICE_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->sliceButtonPressed();
+MidiCommandManager::Command
+MidiCommandManager::getCommand(int controllerNumber) const {
+    if (juce::isPositiveAndBelow(controllerNumber, numControllers))
+        return controllerCommands[size_t(controllerNumber)];
 
-                if (message.getControllerValue() == 0)
-                    listener->sliceButtonReleased();
-            }
+    return Command::none;
+}
 
-            break;
+int MidiCommandManager::getControllerNumber(Command command) const {
+    auto it = std::find(controllerCommands.begin(), controllerCommands.end(),
+                        command);
+    if (command == Command::none || it == controllerCommands.end())
+        return -1;
 
-        case CONTROL_BUTTON:
-            if (message.getControllerValue() == 127) {
-                isControlDown = true;
-                listeners.call([](Listener &l) { l.controlButtonPressed(); });
-            }
+    return int(std::distance(controllerCommands.begin(), it));
+}
 
-            if (message.getControllerValue() == 0) {
-                isControlDown = false;
-                listeners.call([](Listener &l) { l.controlButtonReleased(); });
-            }
+juce::String MidiCommandManager::getCommandName(Command command) {
+    for (const auto &mapping : commandMappings)
+        if (mapping.command == command)
+            return mapping.name;
 
-            break;
+    return {};
+}
 
-        case LOOP_IN_BUTTON:
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.loopInButtonPressed(); });
+MidiCommandManager::Command
+MidiCommandManager::getCommandFromName(const juce::String &name) {
+    for (const auto &mapping : commandMappings)
+        if (name == mapping.name)
+            return mapping.command;
 
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.loopInButtonReleased(); });
+    return Command::none;
+}
 
-            break;
+void MidiCommandManager::setLogVerbosity(LogVerbosity newVerbosity) {
+    logVerbosity = newVerbosity;
+}
 
-        case LOOP_OUT_BUTTON:
-            if (message.getControllerValue() == 127)
-                listeners.call([](Listener &l) { l.loopOutButtonPressed(); });
+void MidiCommandManager::dispatchEncoderMove(int encoder, int delta) {
+    double velocity = 0.0;
 
-            if (message.getControllerValue() == 0)
-                listeners.call([](Listener &l) { l.loopOutButtonReleased(); });
+    if (encoder >= 1 && encoder <= numEncoders) {
+        auto now = juce::Time::getMillisecondCounterHiRes();
+        auto elapsed = now - lastEncoderMoveMs[size_t(encoder)];
+        lastEncoderMoveMs[size_t(encoder)] = now;
 
-            break;
+        if (elapsed > 0.0 && elapsed < encoderIdleMs)
+            velocity = std::abs(delta) * 1000.0 / elapsed;
+    }
 
-        case LOOP_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (isControlDown) {
-                    if (message.getControllerValue() == 127)
-                        listener->undoButtonPressed();
+    if (focusedListener != nullptr)
+        focusedListener->encoderMoved(encoder, delta, velocity);
+}
 
-                    if (message.getControllerValue() == 0)
-                        listener->undoButtonReleased();
+void MidiCommandManager::setEncoderAcceleration(
+    int encoder, const EncoderAcceleration &acceleration) {
+    jassert(encoder >= 1 && encoder <= numEncoders);
+    jassert(acceleration.maxVelocity > acceleration.minVelocity);
+    jassert(acceleration.maxMultiplier >= 1.0);
 
-                } else {
-                    if (message.getControllerValue() == 127)
-                        listener->loopButtonPressed();
+    if (encoder >= 1 && encoder <= numEncoders)
+        encoderAccelerations[size_t(encoder)] = acceleration;
+}
 
-                    if (message.getControllerValue() == 0)
-                        listener->loopButtonReleased();
-                }
-            }
+MidiCommandManager::EncoderAcceleration
+MidiCommandManager::getEncoderAcceleration(int encoder) const {
+    if (encoder >= 1 && encoder <= numEncoders)
+        return encoderAccelerations[size_t(encoder)];
 
-            break;
+    return {};
+}
 
-        case UNDO_BUTTON:
-            if (auto listener = dynamic_cast<Listener *>(focusedComponent)) {
-                if (message.getControllerValue() == 127)
-                    listener->undoButtonPressed();
+int MidiCommandManager::getAcceleratedDelta(int encoder, int delta,
+                                            double velocity) const {
+    auto acceleration = getEncoderAcceleration(encoder);
+    auto proportion = juce::jlimit(
+        0.0, 1.0,
+        (velocity - acceleration.minVelocity) /
+            (acceleration.maxVelocity - acceleration.minVelocity));
+    auto multiplier = 1.0 + (acceleration.maxMultiplier - 1.0) * proportion;
+
+    auto accelerated = juce::roundToInt(delta * multiplier);
+    return std::abs(accelerated) < std::abs(delta) ? delta : accelerated;
+}
 
-                if (message.getControllerValue() == 0)
-                    listener->undoButtonReleased();
-            }
+int MidiCommandManager::getEncoderNumber(Command command) {
+    switch (command) {
+    case Command::encoder1:
+        return 1;
+    case Command::encoder2:
+        return 2;
+    case Command::encoder3:
+        return 3;
+    case Command::encoder4:
+        return 4;
+    default:
+        return 0;
+    }
+}
 
-            break;
+int MidiCommandManager::getEncoderTick(const juce::MidiMessage &message) const {
+    if (!message.isController() ||
+        getEncoderNumber(getCommand(message.getControllerNumber())) == 0)
+        return 0;
 
-        case OCTAVE_CHANGE:
-            // This should be called for all listeners, not just the currently
-            // focused component controller message values will be between 0 and
-            // 8, 4 is the "home" octave (we will display 0) 0 is min octave
-            // (-4) 8 is max octave (+4)
-            listeners.call([message](Listener &l) {
-                l.octaveChanged(message.getControllerValue() - 4);
-            });
+    if (message.getControllerValue() == 1)
+        return 1;
 
-            break;
+    if (message.getControllerValue() == 127)
+        return -1;
 
-        case PLUS_BUTTON:
-            if (message.getControllerValue() == 127) {
-                isPlusDown = true;
-                listeners.call([](Listener &l) { l.plusButtonPressed(); });
-            }
+    return 0;
+}
 
-            if (message.getControllerValue() == 0) {
-                isPlusDown = false;
-                listeners.call([](Listener &l) { l.plusButtonReleased(); });
-            }
+void MidiCommandManager::midiMessageReceived(const juce::MidiMessage &message,
+                                             const juce::String & /*source*/) {
+    auto command = message.isController()
+                       ? getCommand(message.getControllerNumber())
+                       : Command::none;
 
-            break;
+    if (logVerbosity == LogVerbosity::all ||
+        (logVerbosity == LogVerbosity::unmapped && command == Command::none))
+        AsyncFileLogger::write(AsyncFileLogger::Level::debug,
+                               getMidiMessageDescription(message));
 
-        case MINUS_BUTTON:
-            if (message.getControllerValue() == 127) {
-                isMinusDown = true;
-                listeners.call([](Listener &l) { l.minusButtonPressed(); });
-            }
+    if (message.isNoteOn()) {
+        if (focusedListener != nullptr)
+            focusedListener->noteOnPressed(message.getNoteNumber());
+    }
 
-            if (message.getControllerValue() == 0) {
-                isMinusDown = false;
-                listeners.call([](Listener &l) { l.minusButtonReleased(); });
-            }
+    if (message.isController()) {
+        listeners.call([message](Listener &l) {
+            l.controllerEventReceived(message.getControllerNumber(),
+                                      message.getControllerValue());
+        });
 
-            break;
+        handleCommand(command, message.getControllerValue());
+    }
+}
 
-        default:
-            break;
-        }
+void MidiCommandManager::handleCommand(Command command, int value) {
+    switch (command) {
+    case Command::encoder1:
+    case Command::encoder2:
+    case Command::encoder3:
+    case Command::encoder4:
+        if (value == 1)
+            dispatchEncoderMove(getEncoderNumber(command), 1);
+
+        if (value == 127)
+            dispatchEncoderMove(getEncoderNumber(command), -1);
+
+        break;
+
+    case Command::encoder1Button:
+        dispatchButton(value, &Listener::encoder1ButtonPressed,
+                       &Listener::encoder1ButtonReleased, false);
+        break;
+
+    case Command::encoder2Button:
+        dispatchButton(value, &Listener::encoder2ButtonPressed,
+                       &Listener::encoder2ButtonReleased, false);
+        break;
+
+    case Command::encoder3Button:
+        dispatchButton(value, &Listener::encoder3ButtonPressed,
+                       &Listener::encoder3ButtonReleased, false);
+        break;
+
+    case Command::encoder4Button:
+        dispatchButton(value, &Listener::encoder4ButtonPressed,
+                       &Listener::encoder4ButtonReleased, false);
+        break;
+
+    case Command::tracks:
+        dispatchButton(value, &Listener::tracksButtonPressed,
+                       &Listener::tracksButtonReleased, true);
+        break;
+
+    case Command::mixer:
+        dispatchButton(value, &Listener::mixerButtonPressed,
+                       &Listener::mixerButtonReleased, true);
+        break;
+
+    case Command::plugins:
+        dispatchButton(value, &Listener::pluginsButtonPressed,
+                       &Listener::pluginsButtonReleased, true);
+        break;
+
+    case Command::modifiers:
+        dispatchButton(value, &Listener::modifiersButtonPressed,
+                       &Listener::modifiersButtonReleased, true);
+        break;
+
+    case Command::settings:
+        dispatchButton(value, &Listener::settingsButtonPressed,
+                       &Listener::settingsButtonReleased, true);
+        break;
+
+    case Command::tempoSettings:
+        dispatchButton(value, &Listener::tempoSettingsButtonPressed,
+                       &Listener::tempoSettingsButtonReleased, true);
+        break;
+
+    case Command::save:
+        if (isControlDown)
+            dispatchButton(value, &Listener::renderButtonPressed,
+                           &Listener::renderButtonReleased, true);
+        else
+            dispatchButton(value, &Listener::saveButtonPressed,
+                           &Listener::saveButtonReleased, true);
+
+        break;
+
+    case Command::record:
+        dispatchButton(value, &Listener::recordButtonPressed,
+                       &Listener::recordButtonReleased, false);
+        break;
+
+    case Command::play:
+        dispatchButton(value, &Listener::playButtonPressed,
+                       &Listener::playButtonReleased, false);
+        break;
+
+    case Command::stop:
+        dispatchButton(value, &Listener::stopButtonPressed,
+                       &Listener::stopButtonReleased, false);
+        break;
+
+    case Command::sequencers:
+        dispatchButton(value, &Listener::sequencersButtonPressed,
+                       &Listener::sequencersButtonReleased, true);
+        break;
+
+    case Command::cut:
+        dispatchButton(value, &Listener::cutButtonPressed,
+                       &Listener::cutButtonReleased, false);
+        break;
+
+    case Command::paste:
+        dispatchButton(value, &Listener::pasteButtonPressed,
+                       &Listener::pasteButtonReleased, false);
+        break;
+
+    case Command::slice:
+        dispatchButton(value, &Listener::sliceButtonPressed,
+                       &Listener::sliceButtonReleased, false);
+        break;
+
+    case Command::control:
+        if (value == 127)
+            isControlDown = true;
+
+        if (value == 0)
+            isControlDown = false;
+
+        dispatchButton(value, &Listener::controlButtonPressed,
+                       &Listener::controlButtonReleased, true);
+        break;
+
+    case Command::loopIn:
+        dispatchButton(value, &Listener::loopInButtonPressed,
+                       &Listener::loopInButtonReleased, true);
+        break;
+
+    case Command::loopOut:
+        dispatchButton(value, &Listener::loopOutButtonPressed,
+                       &Listener::loopOutButtonReleased, true);
+        break;
+
+    case Command::loop:
+        if (isControlDown)
+            dispatchButton(value, &Listener::undoButtonPressed,
+                           &Listener::undoButtonReleased, false);
+        else
+            dispatchButton(value, &Listener::loopButtonPressed,
+                           &Listener::loopButtonReleased, false);
+
+        break;
+
+    case Command::undo:
+        dispatchButton(value, &Listener::undoButtonPressed,
+                       &Listener::undoButtonReleased, false);
+        break;
+
+    case Command::octave:
+        // controller message values will be between 0 and 8, 4 is the "home"
+        // octave (we will display 0) 0 is min octave (-4) 8 is max octave (+4)
+        listeners.call([value](Listener &l) { l.octaveChanged(value - 4); });
+        break;
+
+    case Command::plus:
+        if (value == 127)
+            isPlusDown = true;
+
+        if (value == 0)
+            isPlusDown = false;
+
+        dispatchButton(value, &Listener::plusButtonPressed,
+                       &Listener::plusButtonReleased, true);
+        break;
+
+    case Command::minus:
+        if (value == 127)
+            isMinusDown = true;
+
+        if (value == 0)
+            isMinusDown = false;
+
+        dispatchButton(value, &Listener::minusButtonPressed,
+                       &Listener::minusButtonReleased, true);
+        break;
+
+    default:
+        break;
     }
 }
 
+void MidiCommandManager::dispatchButton(int value, void (Listener::*pressed)(),
+                                        void (Listener::*released)(),
+                                        bool sendToAllListeners) {
+    auto callback = value == 127 ? pressed : value == 0 ? released : nullptr;
+    if (callback == nullptr)
+        return;
+
+    if (sendToAllListeners)
+        listeners.call([callback](Listener &l) { (l.*callback)(); });
+    else if (focusedListener != nullptr)
+        (focusedListener->*callback)();
+}
+
 juce::String
 MidiCommandManager::getMidiMessageDescription(const juce::MidiMessage &m) {
     if (m.isNoteOn())
@@ -460,6 +555,44 @@ MidiCommandManager::getMidiMessageDescription(const juce::MidiMessage &m) {
     return juce::String::toHexString(m.getRawData(), m.getRawDataSize());
 }
 
+void MidiCommandManager::Listener::encoderMoved(int encoder, int delta,
+                                                double /*velocity*/) {
+    for (int i = 0; i < std::abs(delta); i++) {
+        bool increased = delta > 0;
+        switch (encoder) {
+        case 1:
+            increased ? encoder1Increased() : encoder1Decreased();
+            break;
+        case 2:
+            increased ? encoder2Increased() : encoder2Decreased();
+            break;
+        case 3:
+            increased ? encoder3Increased() : encoder3Decreased();
+            break;
+        case 4:
+            increased ? encoder4Increased() : encoder4Decreased();
+            break;
+        case 5:
+            increased ? encoder5Increased() : encoder5Decreased();
+            break;
+        case 6:
+            increased ? encoder6Increased() : encoder6Decreased();
+            break;
+        case 7:
+            increased ? encoder7Increased() : encoder7Decreased();
+            break;
+        case 8:
+            increased ? encoder8Increased() : encoder8Decreased();
+            break;
+        case 9:
+            increased ? encoder9Increased() : encoder9Decreased();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 void MidiCommandManager::addListener(MidiCommandManager::Listener *l) {
     listeners.add(l);
 }
@@ -1,7 +1,8 @@
 #pragma once
 namespace app_services {
 
-class MidiCommandManager : private juce::MidiInputCallback {
+class MidiCommandManager : private juce::MidiInputCallback,
+                           private juce::AsyncUpdater {
   public:
     explicit MidiCommandManager(tracktion::Engine &e);
     ~MidiCommandManager() override;
@@ -22,6 +23,16 @@ class MidiCommandManager : private juce::MidiInputCallback {
 
         virtual void noteOnPressed(int /*noteNumber*/) {}
 
+        /**
+         * Called once per batch of ticks received for the same encoder,
+         * delta is the number of ticks (negative when turned down) and
+         * velocity the turning speed in ticks per second (0 when the
+         * encoder was idle). Use `getAcceleratedDelta()` to apply the
+         * encoder acceleration curve.
+         * By default it calls encoderNIncreased/Decreased for each tick.
+         */
+        virtual void encoderMoved(int encoder, int delta, double velocity);
+
         virtual void encoder1Increased() {}
         virtual void encoder1Decreased() {}
         virtual void encoder1ButtonPressed() {}
@@ -138,65 +149,145 @@ class MidiCommandManager : private juce::MidiInputCallback {
 
     void removeListener(Listener *l);
 
+    /**
+     * Delta multiplier applied by `getAcceleratedDelta()`: 1 up to
+     * minVelocity, rising linearly to maxMultiplier at maxVelocity
+     * (velocities are in ticks per second).
+     */
+    struct EncoderAcceleration {
+        double minVelocity = 10.0;
+        double maxVelocity = 50.0;
+        double maxMultiplier = 1.0;
+    };
+
+    static constexpr int numEncoders = 9;
+
+    void setEncoderAcceleration(int encoder,
+                                const EncoderAcceleration &acceleration);
+    EncoderAcceleration getEncoderAcceleration(int encoder) const;
+
+    /**
+     * Scale the ticks received by `Listener::encoderMoved()` with the
+     * acceleration curve of the encoder. The result is never smaller than
+     * delta.
+     */
+    int getAcceleratedDelta(int encoder, int delta, double velocity) const;
+
+    /**
+     * Actions the controllers of the control surface can be mapped to
+     */
+    enum class Command {
+        none,
+        encoder1,
+        encoder2,
+        encoder3,
+        encoder4,
+        encoder1Button,
+        encoder2Button,
+        encoder3Button,
+        encoder4Button,
+        undo,
+        tempoSettings,
+        save,
+        settings,
+        tracks,
+        mixer,
+        plugins,
+        modifiers,
+        sequencers,
+        loopIn,
+        loopOut,
+        loop,
+        cut,
+        paste,
+        slice,
+        record,
+        play,
+        stop,
+        control,
+        octave,
+        plus,
+        minus
+    };
+
+    static constexpr int numControllers = 128;
+
+    /**
+     * Map a controller number to a command, the controller previously mapped
+     * to this command is unmapped.
+     */
+    void mapController(Command command, int controllerNumber);
+    /**
+     * Restore the LMN-3 controller layout
+     */
+    void resetControllerMapping();
+    Command getCommand(int controllerNumber) const;
+    int getControllerNumber(Command command) const;
+
+    /**
+     * Name of the command in config.yaml, for example "encoder-1-button"
+     */
+    static juce::String getCommandName(Command command);
+    static Command getCommandFromName(const juce::String &name);
+
+    enum class LogVerbosity {
+        none,
+        // only log messages that are not mapped to a command
+        unmapped,
+        all
+    };
+
+    void setLogVerbosity(LogVerbosity newVerbosity);
+    LogVerbosity getLogVerbosity() const { return logVerbosity; }
+
   private:
     tracktion::Engine &engine;
-    juce::Component *focusedComponent;
+    juce::Component *focusedComponent = nullptr;
+    // resolved when the focus changes, null if the component isn't a listener
+    Listener *focusedListener = nullptr;
     juce::ListenerList<Listener> listeners;
 
-    // This is used to dispach an incoming message to the message thread
-    class IncomingMessageCallback : public juce::CallbackMessage {
-      public:
-        IncomingMessageCallback(MidiCommandManager &o,
-                                const juce::MidiMessage &m,
-                                const juce::String &s)
-            : owner(o), message(m), source(s) {}
-
-        void messageCallback() override {
-            owner.midiMessageReceived(message, source);
-        }
-
-        MidiCommandManager &owner;
-        juce::MidiMessage message;
-        juce::String source;
+    // Incoming messages are copied to a preallocated ring buffer on the midi
+    // thread and dispatched by a single callback on the message thread.
+    struct IncomingMessage {
+        juce::uint8 data[3];
+        int size;
     };
 
+    static constexpr int incomingMessagesCapacity = 512;
+    juce::AbstractFifo incomingFifo{incomingMessagesCapacity};
+    std::array<IncomingMessage, incomingMessagesCapacity> incomingMessages;
+    // only taken by the midi input threads, the reader never locks
+    juce::SpinLock incomingWriteLock;
+    std::atomic<int> numDroppedMessages{0};
+
+    // ticks closer than this belong to the same sweep
+    static constexpr double encoderIdleMs = 250.0;
+    std::array<EncoderAcceleration, numEncoders + 1> encoderAccelerations;
+    std::array<double, numEncoders + 1> lastEncoderMoveMs{};
+
+    std::array<Command, numControllers> controllerCommands{};
+    LogVerbosity logVerbosity = LogVerbosity::none;
+
     void handleIncomingMidiMessage(juce::MidiInput *source,
                                    const juce::MidiMessage &message) override;
+    void handleAsyncUpdate() override;
+
+    void dispatchEncoderMove(int encoder, int delta);
+    // 1 to 4 for the encoder commands, 0 for any other command
+    static int getEncoderNumber(Command command);
+    // 1 or -1 for an encoder tick, 0 for any other message
+    int getEncoderTick(const juce::MidiMessage &message) const;
+
+    void handleCommand(Command command, int value);
+    /**
+     * Call pressed or released on the focused listener, or on every listener
+     * for the global buttons
+     */
+    void dispatchButton(int value, void (Listener::*pressed)(),
+                        void (Listener::*released)(), bool sendToAllListeners);
 
     static juce::String getMidiMessageDescription(const juce::MidiMessage &m);
-
-    static constexpr int encoder1 = 3;
-    // Midi mapping
-    static constexpr int ENCODER_1 = 3;
-    static constexpr int ENCODER_2 = 9;
-    static constexpr int ENCODER_3 = 14;
-    static constexpr int ENCODER_4 = 15;
-    static constexpr int ENCODER_1_BUTTON = 20;
-    static constexpr int ENCODER_2_BUTTON = 21;
-    static constexpr int ENCODER_3_BUTTON = 22;
-    static constexpr int ENCODER_4_BUTTON = 23;
-    static constexpr int UNDO_BUTTON = 24;
-    static constexpr int TEMPO_BUTTON = 25;
-    static constexpr int SAVE_BUTTON = 26;
-    static constexpr int SETTINGS_BUTTON = 85;
-    static constexpr int TRACKS_BUTTON = 86;
-    static constexpr int MIXER_BUTTON = 88;
-    static constexpr int PLUGINS_BUTTON = 89;
-    static constexpr int MODIFIERS_BUTTON = 90;
-    static constexpr int SEQUENCERS_BUTTON = 102;
-    static constexpr int LOOP_IN_BUTTON = 103;
-    static constexpr int LOOP_OUT_BUTTON = 104;
-    static constexpr int LOOP_BUTTON = 105;
-    static constexpr int CUT_BUTTON = 106;
-    static constexpr int PASTE_BUTTON = 107;
-    static constexpr int SLICE_BUTTON = 108;
-    static constexpr int RECORD_BUTTON = 109;
-    static constexpr int PLAY_BUTTON = 110;
-    static constexpr int STOP_BUTTON = 111;
-    static constexpr int CONTROL_BUTTON = 112;
-    static constexpr int OCTAVE_CHANGE = 117;
-    static constexpr int PLUS_BUTTON = 118;
-    static constexpr int MINUS_BUTTON = 119;
 };
 
 } // namespace app_services
@@ -0,0 +1,207 @@
+#include "PeakCache.h"
+
+namespace app_services {
+
+juce::Range<float> PeakCache::Peaks::getPeak(double startSample,
+                                             double endSample) const {
+    if (levels.empty())
+        return {};
+
+    // the levels go from the finest to the coarsest
+    const Level *level = &levels.front();
+    for (const auto &l : levels)
+        if (l.samplesPerPeak <= endSample - startSample)
+            level = &l;
+
+    auto numPeaks = int(level->peaks.size());
+    auto first = juce::jmax(0, int(startSample / level->samplesPerPeak));
+    auto end = int(std::ceil(endSample / level->samplesPerPeak));
+    auto last = juce::jmin(numPeaks, juce::jmax(first + 1, end));
+    if (first >= last)
+        return {};
+
+    auto peak = level->peaks[size_t(first)];
+    for (int i = first + 1; i < last; ++i)
+        peak = peak.getUnionWith(level->peaks[size_t(i)]);
+
+    return peak;
+}
+
+class PeakCache::PeaksJob : public juce::ThreadPoolJob {
+  public:
+    PeaksJob(PeakCache &c, const juce::File &f, juce::Time t)
+        : juce::ThreadPoolJob("Peaks"), cache(c), file(f),
+          modificationTime(t) {}
+
+    JobStatus runJob() override {
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            cache.formatManager.createReaderFor(file));
+
+        Handle peaks;
+        if (reader != nullptr)
+            peaks = computePeaks(*reader, [this] { return shouldExit(); });
+
+        if (!shouldExit())
+            cache.peaksComputed(file, modificationTime, std::move(peaks));
+
+        return jobHasFinished;
+    }
+
+  private:
+    PeakCache &cache;
+    const juce::File file;
+    const juce::Time modificationTime;
+};
+
+PeakCache::PeakCache() { formatManager.registerBasicFormats(); }
+
+PeakCache::~PeakCache() {
+    threadPool.removeAllJobs(true, 4000);
+    cancelPendingUpdate();
+}
+
+PeakCache::Handle PeakCache::get(const juce::File &file) {
+    auto key = file.getFullPathName();
+    auto modificationTime = file.getLastModificationTime();
+
+    const juce::ScopedLock sl(lock);
+
+    // the peaks no clip holds anymore, except the ones whose listeners
+    // haven't been called yet
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->first != key && isUnused(it->second) &&
+            !readyFiles.contains(juce::File(it->first)))
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+
+    // nullptr while they are computed
+    auto found = entries.find(key);
+    if (found != entries.end() &&
+        found->second.modificationTime == modificationTime)
+        return found->second.peaks;
+
+    entries[key] = {nullptr, modificationTime};
+    threadPool.addJob(new PeaksJob(*this, file, modificationTime), true);
+    return nullptr;
+}
+
+void PeakCache::addListener(Listener *l) { listeners.add(l); }
+
+void PeakCache::removeListener(Listener *l) { listeners.remove(l); }
+
+void PeakCache::peaksComputed(const juce::File &file,
+                              juce::Time modificationTime, Handle peaks) {
+    {
+        const juce::ScopedLock sl(lock);
+
+        // the file has been modified since, a newer job computes its peaks
+        auto found = entries.find(file.getFullPathName());
+        if (found == entries.end() ||
+            found->second.modificationTime != modificationTime)
+            return;
+
+        // the file couldn't be read, the next request tries again
+        if (peaks == nullptr) {
+            entries.erase(found);
+            return;
+        }
+
+        found->second.peaks = std::move(peaks);
+        readyFiles.addIfNotAlreadyThere(file);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void PeakCache::handleAsyncUpdate() {
+    juce::Array<juce::File> files;
+
+    {
+        const juce::ScopedLock sl(lock);
+        files = readyFiles;
+    }
+
+    for (const auto &file : files) {
+        listeners.call([&file](Listener &l) { l.peaksReady(file); });
+
+        // the peaks no clip has taken
+        const juce::ScopedLock sl(lock);
+        readyFiles.removeFirstMatchingValue(file);
+
+        auto found = entries.find(file.getFullPathName());
+        if (found != entries.end() && isUnused(found->second))
+            entries.erase(found);
+    }
+}
+
+bool PeakCache::isUnused(const Entry &entry) {
+    return entry.peaks != nullptr && entry.peaks.use_count() == 1;
+}
+
+PeakCache::Handle
+PeakCache::computePeaks(juce::AudioFormatReader &reader,
+                        const std::function<bool()> &shouldExit) {
+    auto peaks = std::make_shared<Peaks>();
+    peaks->sampleRate = reader.sampleRate;
+    peaks->lengthInSamples = reader.lengthInSamples;
+
+    auto numChannels = int(reader.numChannels);
+    if (numChannels == 0)
+        return nullptr;
+
+    Peaks::Level base{baseSamplesPerPeak, {}};
+    base.peaks.reserve(size_t(reader.lengthInSamples / baseSamplesPerPeak + 1));
+
+    // a whole number of peaks per block
+    const int blockSize = 256 * baseSamplesPerPeak;
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+
+    for (juce::int64 position = 0; position < reader.lengthInSamples;
+         position += blockSize) {
+        if (shouldExit())
+            return nullptr;
+
+        auto numSamples = int(juce::jmin(juce::int64(blockSize),
+                                         reader.lengthInSamples - position));
+        reader.read(&buffer, 0, numSamples, position, true, true);
+
+        for (int start = 0; start < numSamples; start += baseSamplesPerPeak) {
+            auto num = juce::jmin(baseSamplesPerPeak, numSamples - start);
+
+            auto peak = juce::FloatVectorOperations::findMinAndMax(
+                buffer.getReadPointer(0, start), num);
+            for (int channel = 1; channel < numChannels; ++channel)
+                peak = peak.getUnionWith(
+                    juce::FloatVectorOperations::findMinAndMax(
+                        buffer.getReadPointer(channel, start), num));
+
+            base.peaks.push_back(peak);
+        }
+    }
+
+    peaks->levels.push_back(std::move(base));
+
+    // halve the resolution until a single peak covers the whole file
+    while (peaks->levels.back().peaks.size() > 1) {
+        const auto &previous = peaks->levels.back().peaks;
+
+        Peaks::Level level{peaks->levels.back().samplesPerPeak * 2, {}};
+        level.peaks.reserve(previous.size() / 2 + 1);
+
+        for (size_t i = 0; i < previous.size(); i += 2) {
+            auto peak = previous[i];
+            if (i + 1 < previous.size())
+                peak = peak.getUnionWith(previous[i + 1]);
+
+            level.peaks.push_back(peak);
+        }
+
+        peaks->levels.push_back(std::move(level));
+    }
+
+    return peaks;
+}
+
+} // namespace app_services
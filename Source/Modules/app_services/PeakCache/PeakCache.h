@@ -0,0 +1,102 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Min/max peaks of audio files at several resolutions, for drawing audio
+ * clips at any zoom without decoding on the message thread.
+ * Peaks are computed on a background thread the first time a file is
+ * requested and shared by every clip of the file. They are dropped once no
+ * clip holds them anymore, or once the listeners have been called if no clip
+ * has taken them. A file which can't be read is tried again on the next
+ * request.
+ *
+ * Use it through `juce::SharedResourcePointer<PeakCache>`.
+ */
+class PeakCache : private juce::AsyncUpdater {
+  public:
+    struct Peaks {
+        struct Level {
+            int samplesPerPeak;
+            // of all the channels
+            std::vector<juce::Range<float>> peaks;
+        };
+
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+        // each level has half the resolution of the previous one
+        std::vector<Level> levels;
+
+        /**
+         * Peak of the samples between start and end, read from the coarsest
+         * level which has at least one peak for the range
+         */
+        juce::Range<float> getPeak(double startSample, double endSample) const;
+    };
+
+    /**
+     * Keeps the peaks in memory while it is held
+     */
+    using Handle = std::shared_ptr<const Peaks>;
+
+    PeakCache();
+    ~PeakCache() override;
+
+    /**
+     * Peaks of the file, or nullptr while they are computed. Listeners are
+     * called once they are ready.
+     */
+    Handle get(const juce::File &file);
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called on the message thread when the peaks of a file have been
+         * computed
+         */
+        virtual void peaksReady(const juce::File & /*file*/) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+    /**
+     * Peaks of everything the reader reads, nullptr if shouldExit returns
+     * true before the end or the reader has no channel
+     */
+    static Handle computePeaks(juce::AudioFormatReader &reader,
+                               const std::function<bool()> &shouldExit);
+
+    static constexpr int baseSamplesPerPeak = 256;
+
+  private:
+    class PeaksJob;
+
+    struct Entry {
+        Handle peaks;
+        juce::Time modificationTime;
+    };
+
+    juce::CriticalSection lock;
+    // keyed by full path, entries without peaks are being computed
+    std::map<juce::String, Entry> entries;
+    // computed, until their listeners have been called
+    juce::Array<juce::File> readyFiles;
+
+    juce::ListenerList<Listener> listeners;
+
+    // only used by the job thread
+    juce::AudioFormatManager formatManager;
+    juce::ThreadPool threadPool{1};
+
+    void peaksComputed(const juce::File &file, juce::Time modificationTime,
+                       Handle peaks);
+    void handleAsyncUpdate() override;
+
+    static bool isUnused(const Entry &entry);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PeakCache)
+};
+
+} // namespace app_services
@@ -0,0 +1,137 @@
+#include "ProjectFile.h"
+
+namespace app_services {
+
+juce::String ProjectFile::getWildcard() {
+    return "*" + xmlExtension + ";*" + binaryExtension;
+}
+
+juce::String ProjectFile::getExtension(Format format) {
+    return format == Format::binary ? binaryExtension : xmlExtension;
+}
+
+bool ProjectFile::isProjectFile(const juce::File &file) {
+    return file.hasFileExtension(xmlExtension) ||
+           file.hasFileExtension(binaryExtension);
+}
+
+ProjectFile::Format ProjectFile::getFormatForFile(const juce::File &file) {
+    return file.hasFileExtension(binaryExtension) ? Format::binary
+                                                  : Format::xml;
+}
+
+std::optional<ProjectFile::Format>
+ProjectFile::detectFormat(const juce::File &file) {
+    juce::FileInputStream input(file);
+    if (!input.openedOk())
+        return {};
+
+    juce::uint8 header[2] = {};
+    if (input.read(header, 2) != 2)
+        return {};
+
+    // GZIP magic number
+    if (header[0] == 0x1f && header[1] == 0x8b)
+        return Format::binary;
+
+    return Format::xml;
+}
+
+juce::ValueTree ProjectFile::read(const juce::File &file) {
+    auto format = detectFormat(file);
+    if (!format.has_value())
+        return {};
+
+    if (*format == Format::xml) {
+        if (auto xml = juce::XmlDocument::parse(file))
+            return juce::ValueTree::fromXml(*xml);
+
+        return {};
+    }
+
+    auto input = file.createInputStream();
+    if (input == nullptr)
+        return {};
+
+    juce::GZIPDecompressorInputStream decompressor(
+        input.release(), true, juce::GZIPDecompressorInputStream::gzipFormat);
+    return juce::ValueTree::readFromStream(decompressor);
+}
+
+bool ProjectFile::write(const juce::ValueTree &state,
+                        juce::OutputStream &output, Format format) {
+    if (format == Format::xml) {
+        auto xml = state.createXml();
+        if (xml == nullptr)
+            return false;
+
+        xml->writeTo(output);
+        return true;
+    }
+
+    juce::GZIPCompressorOutputStream compressor(
+        output, 6, juce::GZIPCompressorOutputStream::windowBitsGZIP);
+    state.writeToStream(compressor);
+    compressor.flush();
+    return true;
+}
+
+std::unique_ptr<tracktion::Edit>
+ProjectFile::loadEdit(tracktion::Engine &engine, const juce::File &file) {
+    if (detectFormat(file) != Format::binary)
+        return tracktion::loadEditFromFile(engine, file);
+
+    return loadEdit(engine, read(file), file);
+}
+
+std::unique_ptr<tracktion::Edit>
+ProjectFile::loadEdit(tracktion::Engine &engine, const juce::ValueTree &state,
+                      const juce::File &file) {
+    if (!state.hasType(tracktion::IDs::EDIT)) {
+        AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                               "Invalid project file: " +
+                                   file.getFullPathName());
+        return tracktion::createEmptyEdit(engine, file);
+    }
+
+    // the same upgrade and media lookup as tracktion::loadEditFromFile
+    auto editState = tracktion::updateLegacyEdit(state);
+
+    auto itemID = tracktion::ProjectItemID::fromProperty(
+        editState, tracktion::IDs::projectID);
+    if (!itemID.isValid())
+        itemID = tracktion::ProjectItemID::createNewID(0);
+
+    tracktion::Edit::Options options{engine, editState, itemID};
+    options.editFileRetriever = [file] { return file; };
+    options.filePathResolver = [file](const juce::String &path) {
+        // media paths are relative to the project
+        if (juce::File::isAbsolutePath(path))
+            return juce::File(path);
+
+        return file.getSiblingFile(path);
+    };
+    return std::make_unique<tracktion::Edit>(options);
+}
+
+bool ProjectFile::exportToXml(const juce::File &projectFile,
+                              const juce::File &destination) {
+    auto state = read(projectFile);
+    if (!state.isValid())
+        return false;
+
+    if (!destination.getParentDirectory().createDirectory())
+        return false;
+
+    juce::TemporaryFile temporaryFile(destination);
+
+    {
+        juce::FileOutputStream output(temporaryFile.getFile());
+        if (!output.openedOk() || !write(state, output, Format::xml))
+            return false;
+    }
+
+    return temporaryFile.overwriteTargetFileWithTemporary();
+}
+
+} // namespace app_services
@@ -0,0 +1,63 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Reads and writes project files.
+ * Projects are either XML files or GZIP compressed binary value trees, which
+ * are smaller and faster to load. The format is detected from the content
+ * when reading and chosen from the file extension when writing.
+ */
+class ProjectFile {
+  public:
+    enum class Format { xml, binary };
+
+    static inline const juce::String xmlExtension = ".xml";
+    static inline const juce::String binaryExtension = ".lmn";
+
+    /**
+     * Wildcard matching the project files of both formats
+     */
+    static juce::String getWildcard();
+    static juce::String getExtension(Format format);
+    static bool isProjectFile(const juce::File &file);
+
+    /**
+     * Format used when writing to this file
+     */
+    static Format getFormatForFile(const juce::File &file);
+    /**
+     * Format of an existing file, read from its first bytes
+     */
+    static std::optional<Format> detectFormat(const juce::File &file);
+
+    /**
+     * Read the state stored in a file of either format, returns an invalid
+     * tree if the file can't be read
+     */
+    static juce::ValueTree read(const juce::File &file);
+    static bool write(const juce::ValueTree &state, juce::OutputStream &output,
+                      Format format);
+
+    /**
+     * Load an edit from a file of either format
+     */
+    static std::unique_ptr<tracktion::Edit>
+    loadEdit(tracktion::Engine &engine, const juce::File &file);
+    /**
+     * Load an edit from a state read elsewhere, which is saved to the file.
+     * Older states are upgraded and relative media paths are resolved from
+     * the file, like tracktion::loadEditFromFile does.
+     */
+    static std::unique_ptr<tracktion::Edit>
+    loadEdit(tracktion::Engine &engine, const juce::ValueTree &state,
+             const juce::File &file);
+
+    /**
+     * Write the project as XML to the destination, returns false if the
+     * project can't be read or written
+     */
+    static bool exportToXml(const juce::File &projectFile,
+                            const juce::File &destination);
+};
+
+} // namespace app_services
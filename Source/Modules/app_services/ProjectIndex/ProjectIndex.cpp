@@ -0,0 +1,220 @@
+#include "ProjectIndex.h"
+
+namespace app_services {
+
+namespace {
+const juce::Identifier indexType("PROJECT_INDEX");
+const juce::Identifier projectType("PROJECT");
+const juce::Identifier directoryTimeProperty("directoryTime");
+const juce::Identifier scanTimeProperty("scanTime");
+// directory time produced by the last save, which the index records
+const juce::Identifier savedDirectoryTimeProperty("savedDirectoryTime");
+const juce::Identifier fileNameProperty("fileName");
+const juce::Identifier modificationTimeProperty("modificationTime");
+const juce::Identifier lengthProperty("length");
+const juce::Identifier numTracksProperty("numTracks");
+const juce::Identifier tempoProperty("tempo");
+
+void sortByName(std::vector<ProjectIndex::Entry> &entries) {
+    std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+        return a.file.getFileName().compareNatural(b.file.getFileName()) < 0;
+    });
+}
+} // namespace
+
+std::vector<ProjectIndex::Entry>
+ProjectIndex::getEntries(const juce::File &directory) {
+    const juce::ScopedLock lock(getLock());
+
+    auto indexFile = getIndexFile(directory);
+    auto index = indexFile.existsAsFile() ? ProjectFile::read(indexFile)
+                                          : juce::ValueTree();
+    auto entries = read(index, directory);
+
+    auto directoryTime = directory.getLastModificationTime().toMilliseconds();
+    if (!isValid(index, directoryTime)) {
+        auto scanTime = juce::Time::currentTimeMillis();
+        entries = scan(directory, entries);
+
+        // written from the save thread, the listing doesn't wait for it as
+        // the app holds the service
+        juce::SharedResourcePointer<EditSaveService> saveService;
+        saveService->requestWrite(
+            createIndex(entries, directoryTime, scanTime), indexFile);
+    }
+
+    return entries;
+}
+
+std::optional<ProjectIndex::Entry>
+ProjectIndex::getNewest(const juce::File &directory) {
+    auto entries = getEntries(directory);
+    if (entries.empty())
+        return {};
+
+    return *std::max_element(entries.begin(), entries.end(),
+                             [](const auto &a, const auto &b) {
+                                 return a.modificationTime <
+                                        b.modificationTime;
+                             });
+}
+
+void ProjectIndex::update(const juce::File &file,
+                          const juce::ValueTree &state,
+                          juce::Time previousDirectoryTime) {
+    if (!ProjectFile::isProjectFile(file))
+        return;
+
+    const juce::ScopedLock lock(getLock());
+
+    // the index is created when the directory is listed
+    auto directory = file.getParentDirectory();
+    auto indexFile = getIndexFile(directory);
+    if (!indexFile.existsAsFile())
+        return;
+
+    auto index = ProjectFile::read(indexFile);
+    auto entries = read(index, directory);
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&file](const Entry &entry) {
+                                     return entry.file == file;
+                                 }),
+                  entries.end());
+    entries.push_back(createEntry(file, state));
+    sortByName(entries);
+
+    // the scan time stays the one of the last listing of the directory
+    auto directoryTime = directory.getLastModificationTime().toMilliseconds();
+    auto updated = createIndex(
+        entries, directoryTime,
+        juce::int64(index.getProperty(scanTimeProperty, 0)));
+
+    // the index was up to date before the save, the directory doesn't need
+    // to be scanned again. Otherwise the next listing scans it.
+    if (isValid(index, previousDirectoryTime.toMilliseconds()))
+        updated.setProperty(savedDirectoryTimeProperty, directoryTime,
+                            nullptr);
+
+    if (!EditSaveService::writeAtomically(updated, indexFile))
+        AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                               "Error writing project index: " +
+                                   indexFile.getFullPathName());
+}
+
+juce::File ProjectIndex::getIndexFile(const juce::File &directory) {
+    // outside of the directory, writing it would change the directory
+    return directory.getSiblingFile(directory.getFileName() + ".index");
+}
+
+ProjectIndex::Entry ProjectIndex::createEntry(const juce::File &file,
+                                              const juce::ValueTree &state) {
+    Entry entry;
+    entry.file = file;
+    entry.modificationTime = file.getLastModificationTime();
+    entry.length = file.getSize();
+
+    for (const auto &child : state)
+        if (child.hasType(tracktion::IDs::AUDIOTRACK))
+            entry.numTracks++;
+
+    entry.tempo = state.getChildWithName(tracktion::IDs::TEMPOSEQUENCE)
+                      .getChildWithName(tracktion::IDs::TEMPO)
+                      .getProperty(tracktion::IDs::bpm, 0.0);
+    return entry;
+}
+
+bool ProjectIndex::isUpToDate(const Entry &entry) {
+    return entry.file.getLastModificationTime() == entry.modificationTime &&
+           entry.file.getSize() == entry.length;
+}
+
+bool ProjectIndex::isValid(const juce::ValueTree &index,
+                           juce::int64 directoryTime) {
+    // files added, removed or renamed change the directory
+    if (!index.hasType(indexType) ||
+        juce::int64(index.getProperty(directoryTimeProperty)) != directoryTime)
+        return false;
+
+    if (juce::int64(index.getProperty(savedDirectoryTimeProperty, 0)) ==
+        directoryTime)
+        return true;
+
+    return directoryTime + timeResolutionMs <=
+           juce::int64(index.getProperty(scanTimeProperty, 0));
+}
+
+std::vector<ProjectIndex::Entry>
+ProjectIndex::read(const juce::ValueTree &index, const juce::File &directory) {
+    std::vector<Entry> entries;
+    if (!index.hasType(indexType))
+        return entries;
+
+    for (const auto &project : index) {
+        auto fileName = project[fileNameProperty].toString();
+        if (!project.hasType(projectType) || fileName.isEmpty())
+            continue;
+
+        Entry entry;
+        entry.file = directory.getChildFile(fileName);
+        entry.modificationTime =
+            juce::Time(juce::int64(project[modificationTimeProperty]));
+        entry.length = project[lengthProperty];
+        entry.numTracks = project[numTracksProperty];
+        entry.tempo = project[tempoProperty];
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+juce::ValueTree ProjectIndex::createIndex(const std::vector<Entry> &entries,
+                                          juce::int64 directoryTime,
+                                          juce::int64 scanTime) {
+    juce::ValueTree index(indexType);
+    index.setProperty(directoryTimeProperty, directoryTime, nullptr);
+    index.setProperty(scanTimeProperty, scanTime, nullptr);
+
+    for (const auto &entry : entries) {
+        juce::ValueTree project(projectType);
+        project.setProperty(fileNameProperty, entry.file.getFileName(),
+                            nullptr);
+        project.setProperty(modificationTimeProperty,
+                            entry.modificationTime.toMilliseconds(), nullptr);
+        project.setProperty(lengthProperty, entry.length, nullptr);
+        project.setProperty(numTracksProperty, entry.numTracks, nullptr);
+        project.setProperty(tempoProperty, entry.tempo, nullptr);
+        index.appendChild(project, nullptr);
+    }
+
+    return index;
+}
+
+std::vector<ProjectIndex::Entry>
+ProjectIndex::scan(const juce::File &directory,
+                   const std::vector<Entry> &previous) {
+    std::vector<Entry> entries;
+
+    for (const auto &file : directory.findChildFiles(
+             juce::File::findFiles, false, ProjectFile::getWildcard())) {
+        auto indexed = std::find_if(
+            previous.begin(), previous.end(),
+            [&file](const Entry &entry) { return entry.file == file; });
+
+        // only the projects that changed are read
+        if (indexed != previous.end() && isUpToDate(*indexed))
+            entries.push_back(*indexed);
+        else
+            entries.push_back(createEntry(file, ProjectFile::read(file)));
+    }
+
+    sortByName(entries);
+    return entries;
+}
+
+juce::CriticalSection &ProjectIndex::getLock() {
+    static juce::CriticalSection lock;
+    return lock;
+}
+
+} // namespace app_services
@@ -0,0 +1,72 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Index of the project files in a directory, with the metadata the song
+ * list shows, persisted in a file next to the directory.
+ * The index is updated when a project is saved and checked against the
+ * modification time of the directory when read, so the directory is only
+ * scanned again when files have been added, removed or replaced by
+ * something else. Scanning only reads the projects that changed, and the
+ * index found outdated when listing is written from the save thread.
+ * The save service must be held elsewhere while listing, otherwise releasing
+ * it waits for the write.
+ */
+class ProjectIndex {
+  public:
+    struct Entry {
+        juce::File file;
+        juce::Time modificationTime;
+        juce::int64 length = 0;
+        int numTracks = 0;
+        double tempo = 0.0;
+
+        juce::String getName() const {
+            return file.getFileNameWithoutExtension();
+        }
+    };
+
+    /**
+     * Projects in the directory sorted by name
+     */
+    static std::vector<Entry> getEntries(const juce::File &directory);
+    /**
+     * Most recently modified project in the directory
+     */
+    static std::optional<Entry> getNewest(const juce::File &directory);
+
+    /**
+     * Record a project that has just been written with this state, the
+     * index of its directory is only updated if it exists. The directory
+     * time before the write tells whether the save is the only change
+     * since the index was up to date.
+     */
+    static void update(const juce::File &file, const juce::ValueTree &state,
+                       juce::Time previousDirectoryTime);
+
+    static juce::File getIndexFile(const juce::File &directory);
+
+  private:
+    static Entry createEntry(const juce::File &file,
+                             const juce::ValueTree &state);
+    static bool isUpToDate(const Entry &entry);
+    static bool isValid(const juce::ValueTree &index,
+                        juce::int64 directoryTime);
+
+    static std::vector<Entry> read(const juce::ValueTree &index,
+                                   const juce::File &directory);
+    static juce::ValueTree createIndex(const std::vector<Entry> &entries,
+                                       juce::int64 directoryTime,
+                                       juce::int64 scanTime);
+    static std::vector<Entry> scan(const juce::File &directory,
+                                   const std::vector<Entry> &previous);
+
+    // the index is updated from the save thread
+    static juce::CriticalSection &getLock();
+
+    // modification times have a resolution of a second on some file
+    // systems, changes this close to a scan may not be visible yet
+    static constexpr juce::int64 timeResolutionMs = 2000;
+};
+
+} // namespace app_services
@@ -0,0 +1,480 @@
+#include "SampleCatalog.h"
+#include <yaml-cpp/yaml.h>
+
+#if JUCE_LINUX
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace app_services {
+
+SampleCatalog::SampleCatalog() : juce::Thread("Sample catalog") {
+#if JUCE_LINUX
+    inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyDescriptor < 0)
+        AsyncFileLogger::write(
+            AsyncFileLogger::Level::warning,
+            "Unable to watch the sample library, polling it instead");
+#endif
+}
+
+SampleCatalog::~SampleCatalog() {
+    stopThread(4000);
+    cancelPendingUpdate();
+
+#if JUCE_LINUX
+    if (inotifyDescriptor >= 0)
+        close(inotifyDescriptor);
+#endif
+}
+
+void SampleCatalog::setDirectories(const juce::File &samples,
+                                   const juce::File &kits) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (isThreadRunning() && samples == samplesDirectory &&
+        kits == drumKitsDirectory)
+        return;
+
+    stopThread(4000);
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        samplesDirectory = samples;
+        drumKitsDirectory = kits;
+    }
+
+    restart();
+}
+
+void SampleCatalog::setSources(const juce::File &samples,
+                               const juce::File &kits,
+                               std::function<void(const juce::File &)> sync) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto wasRunning = isThreadRunning();
+    stopThread(4000);
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        samplesSource = samples;
+        drumKitsSource = kits;
+        syncSource = std::move(sync);
+    }
+
+    // otherwise started once the scanned directories are set
+    if (wasRunning)
+        restart();
+}
+
+void SampleCatalog::restart() {
+    stopThread(4000);
+
+#if JUCE_LINUX
+    for (const auto &watched : watchedDirectories)
+        inotify_rm_watch(inotifyDescriptor, watched.first);
+    watchedDirectories.clear();
+#endif
+    polledDirectories.clear();
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        listings.clear();
+        drumKits.clear();
+    }
+
+    startThread();
+}
+
+SampleCatalog::Listing
+SampleCatalog::getListing(const juce::File &directory) {
+    {
+        const juce::ScopedLock lock(catalogLock);
+        auto found = listings.find(directory.getFullPathName());
+        if (found != listings.end())
+            return found->second;
+    }
+
+    // the scanning thread replaces it with the same listing
+    auto listing = readListing(directory);
+
+    const juce::ScopedLock lock(catalogLock);
+    listings.emplace(directory.getFullPathName(), listing);
+    return listing;
+}
+
+std::vector<SampleCatalog::DrumKit> SampleCatalog::getDrumKits() {
+    std::vector<DrumKit> kits;
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        for (const auto &kit : drumKits)
+            kits.push_back(kit.second);
+    }
+
+    std::sort(kits.begin(), kits.end(), [](const auto &a, const auto &b) {
+        return a.name.compareIgnoreCase(b.name) < 0;
+    });
+    return kits;
+}
+
+std::optional<SampleCatalog::DrumKit>
+SampleCatalog::getDrumKit(const juce::File &mappingFile) {
+    {
+        const juce::ScopedLock lock(catalogLock);
+        auto found = drumKits.find(mappingFile.getFullPathName());
+        if (found != drumKits.end())
+            return found->second;
+    }
+
+    return readDrumKit(mappingFile);
+}
+
+std::optional<SampleCatalog::DrumKit>
+SampleCatalog::readDrumKit(const juce::File &mappingFile) {
+    try {
+        YAML::Node node =
+            YAML::LoadFile(mappingFile.getFullPathName().toStdString());
+        if (node.IsNull())
+            return {};
+
+        DrumKit kit;
+        kit.name = node["name"].as<std::string>();
+        kit.mappingFile = mappingFile;
+        kit.modificationTime = mappingFile.getLastModificationTime();
+
+        for (const auto &mapping : node["mappings"])
+            kit.mappings.push_back(
+                {mapping["note_number"].as<int>(),
+                 juce::String(mapping["file_name"].as<std::string>())});
+
+        return kit;
+    } catch (const YAML::Exception &e) {
+        AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                               "unable to read YAML file: " +
+                                   mappingFile.getFullPathName() + ": " +
+                                   e.what());
+        return {};
+    }
+}
+
+void SampleCatalog::addListener(Listener *l) { listeners.add(l); }
+
+void SampleCatalog::removeListener(Listener *l) { listeners.remove(l); }
+
+void SampleCatalog::run() {
+    juce::File samples, kits, samplesSourceDirectory, kitsSourceDirectory;
+    std::function<void(const juce::File &)> sync;
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        samples = samplesDirectory;
+        kits = drumKitsDirectory;
+        samplesSourceDirectory = samplesSource;
+        kitsSourceDirectory = drumKitsSource;
+        sync = syncSource;
+    }
+
+    // the copy of a source directory, or the directory itself without
+    // sources
+    auto getScannedDirectory = [&](const juce::File &directory) {
+        if (sync == nullptr)
+            return directory;
+
+        for (auto [source, scanned] : {std::pair(kitsSourceDirectory, kits),
+                                       std::pair(samplesSourceDirectory,
+                                                 samples)})
+            if (directory == source || directory.isAChildOf(source))
+                return scanned.getChildFile(
+                    directory.getRelativePathFrom(source));
+
+        return juce::File();
+    };
+
+    isWatchingSources = sync != nullptr;
+    if (isWatchingSources) {
+        watchTree(kitsSourceDirectory);
+        watchTree(samplesSourceDirectory);
+    }
+
+    filesWithoutPeaks.clearQuick();
+    scanDirectory(kits);
+    // the drum samplers opened during the scan get the kits
+    triggerAsyncUpdate();
+    scanDirectory(samples);
+    createPeaks();
+
+    while (!threadShouldExit()) {
+        auto changedDirectories = waitForChanges();
+        if (changedDirectories.isEmpty())
+            continue;
+
+        if (isWatchingSources) {
+            for (const auto &source :
+                 {kitsSourceDirectory, samplesSourceDirectory}) {
+                auto isChanged = std::any_of(
+                    changedDirectories.begin(), changedDirectories.end(),
+                    [&source](const juce::File &directory) {
+                        return directory == source ||
+                               directory.isAChildOf(source);
+                    });
+                if (isChanged)
+                    sync(source);
+            }
+
+            // the directories created in the sources
+            for (const auto &directory : changedDirectories)
+                if (directory.isDirectory())
+                    watchTree(directory);
+        }
+
+        for (const auto &directory : changedDirectories)
+            if (auto scanned = getScannedDirectory(directory);
+                scanned != juce::File())
+                rescanDirectory(scanned);
+
+        triggerAsyncUpdate();
+        createPeaks();
+    }
+}
+
+void SampleCatalog::handleAsyncUpdate() {
+    listeners.call([](Listener &l) { l.sampleCatalogChanged(); });
+}
+
+void SampleCatalog::scanDirectory(const juce::File &directory) {
+    if (threadShouldExit() || !directory.isDirectory())
+        return;
+
+    // the sources are watched instead
+    if (!isWatchingSources)
+        watch(directory);
+
+    auto listing = readListing(directory);
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        listings[directory.getFullPathName()] = listing;
+    }
+
+    updateDrumKits(directory, listing);
+    filesWithoutPeaks.addArray(listing.files);
+
+    for (const auto &subDirectory : listing.directories)
+        scanDirectory(subDirectory);
+}
+
+void SampleCatalog::rescanDirectory(const juce::File &directory) {
+    if (!directory.isDirectory()) {
+        removeDirectory(directory);
+        return;
+    }
+
+    auto listing = readListing(directory);
+    Listing previous;
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        auto &cached = listings[directory.getFullPathName()];
+        previous = cached;
+        cached = listing;
+    }
+
+    for (const auto &subDirectory : listing.directories)
+        if (!previous.directories.contains(subDirectory))
+            scanDirectory(subDirectory);
+
+    for (const auto &subDirectory : previous.directories)
+        if (!listing.directories.contains(subDirectory))
+            removeDirectory(subDirectory);
+
+    updateDrumKits(directory, listing);
+    // the cache skips the files whose peaks are already written
+    filesWithoutPeaks.addArray(listing.files);
+}
+
+void SampleCatalog::removeDirectory(const juce::File &directory) {
+    const juce::ScopedLock lock(catalogLock);
+
+    auto isRemoved = [&directory](const juce::File &file) {
+        return file == directory || file.isAChildOf(directory);
+    };
+
+    for (auto it = listings.begin(); it != listings.end();)
+        it = isRemoved(juce::File(it->first)) ? listings.erase(it) : ++it;
+
+    for (auto it = drumKits.begin(); it != drumKits.end();)
+        it = isRemoved(it->second.mappingFile) ? drumKits.erase(it) : ++it;
+}
+
+void SampleCatalog::updateDrumKits(const juce::File &directory,
+                                   const Listing &listing) {
+    juce::File kits;
+    std::vector<DrumKit> knownKits;
+
+    {
+        const juce::ScopedLock lock(catalogLock);
+        kits = drumKitsDirectory;
+
+        // forget the kits which have been removed from this directory
+        for (auto it = drumKits.begin(); it != drumKits.end();) {
+            const auto &mappingFile = it->second.mappingFile;
+            if (mappingFile.getParentDirectory() == directory &&
+                !listing.files.contains(mappingFile))
+                it = drumKits.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    if (directory != kits && !directory.isAChildOf(kits))
+        return;
+
+    for (const auto &file : listing.files) {
+        if (!file.hasFileExtension(".yaml"))
+            continue;
+
+        {
+            const juce::ScopedLock lock(catalogLock);
+            auto found = drumKits.find(file.getFullPathName());
+            if (found != drumKits.end() && found->second.modificationTime ==
+                                               file.getLastModificationTime())
+                continue;
+        }
+
+        // parsed without holding the lock
+        auto kit = readDrumKit(file);
+
+        const juce::ScopedLock lock(catalogLock);
+        if (kit.has_value())
+            drumKits[file.getFullPathName()] = std::move(*kit);
+        else
+            drumKits.erase(file.getFullPathName());
+    }
+}
+
+juce::Array<juce::File> SampleCatalog::waitForChanges() {
+    juce::Array<juce::File> changedDirectories;
+
+#if JUCE_LINUX
+    if (inotifyDescriptor >= 0) {
+        pollfd descriptor{inotifyDescriptor, POLLIN, 0};
+        if (poll(&descriptor, 1, pollIntervalMs) <= 0)
+            return changedDirectories;
+
+        alignas(inotify_event) char buffer[4096];
+
+        for (;;) {
+            auto length = read(inotifyDescriptor, buffer, sizeof(buffer));
+            if (length <= 0)
+                break;
+
+            for (char *position = buffer; position < buffer + length;) {
+                auto *event = reinterpret_cast<inotify_event *>(position);
+                position += sizeof(inotify_event) + event->len;
+
+                auto watched = watchedDirectories.find(event->wd);
+                if (watched == watchedDirectories.end())
+                    continue;
+
+                changedDirectories.addIfNotAlreadyThere(watched->second);
+
+                // the directory has been removed
+                if ((event->mask & IN_IGNORED) != 0)
+                    watchedDirectories.erase(watched);
+            }
+        }
+
+        return changedDirectories;
+    }
+#endif
+
+    wait(pollIntervalMs);
+
+    for (auto it = polledDirectories.begin(); it != polledDirectories.end();) {
+        juce::File directory(it->first);
+        auto times = readPollTimes(directory);
+        if (times != it->second)
+            changedDirectories.add(directory);
+
+        if (!directory.isDirectory()) {
+            it = polledDirectories.erase(it);
+            continue;
+        }
+
+        it->second = times;
+        ++it;
+    }
+
+    return changedDirectories;
+}
+
+void SampleCatalog::watch(const juce::File &directory) {
+#if JUCE_LINUX
+    if (inotifyDescriptor >= 0) {
+        auto descriptor = inotify_add_watch(
+            inotifyDescriptor, directory.getFullPathName().toRawUTF8(),
+            IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                IN_CLOSE_WRITE | IN_DELETE_SELF);
+        if (descriptor >= 0)
+            watchedDirectories[descriptor] = directory;
+
+        return;
+    }
+#endif
+
+    // already polled directories keep their times
+    polledDirectories.emplace(directory.getFullPathName(),
+                              readPollTimes(directory));
+}
+
+void SampleCatalog::watchTree(const juce::File &directory) {
+    if (!directory.isDirectory())
+        return;
+
+    watch(directory);
+    for (const auto &subDirectory :
+         directory.findChildFiles(juce::File::findDirectories, true))
+        watch(subDirectory);
+}
+
+void SampleCatalog::createPeaks() {
+    // the kits are listed first, their samples get their peaks first
+    for (const auto &file : filesWithoutPeaks) {
+        if (threadShouldExit())
+            break;
+
+        waveformCache->createPeaks(file);
+    }
+
+    filesWithoutPeaks.clearQuick();
+}
+
+SampleCatalog::Listing SampleCatalog::readListing(const juce::File &directory) {
+    Listing listing;
+    listing.modificationTime = directory.getLastModificationTime();
+    listing.directories =
+        directory.findChildFiles(juce::File::findDirectories, false);
+    listing.directories.sort();
+    listing.files = directory.findChildFiles(juce::File::findFiles, false);
+    listing.files.sort();
+    return listing;
+}
+
+juce::Array<juce::Time>
+SampleCatalog::readPollTimes(const juce::File &directory) {
+    // adding, removing or renaming a file changes the time of its directory,
+    // only the mapping files are checked for changes made in place
+    juce::Array<juce::Time> times{directory.getLastModificationTime()};
+
+    auto mappingFiles =
+        directory.findChildFiles(juce::File::findFiles, false, "*.yaml");
+    mappingFiles.sort();
+    for (const auto &file : mappingFiles)
+        times.add(file.getLastModificationTime());
+
+    return times;
+}
+
+} // namespace app_services
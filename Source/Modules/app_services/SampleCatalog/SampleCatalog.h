@@ -0,0 +1,136 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Listings of the sample library and of the drum kits it contains.
+ * The library is scanned once on a background thread, the listings are then
+ * served from memory and updated incrementally when the directories change,
+ * watched with inotify on Linux and polled elsewhere. When the scanned
+ * directories are copies of the directories the user edits, the sources are
+ * watched instead and synced before the copies are listed again. Drum kit
+ * mapping files
+ * are parsed when they are found or modified, and the waveform peaks of new
+ * samples are written to the WaveformCache once the listings are up to date.
+ *
+ * Use it through `juce::SharedResourcePointer<SampleCatalog>`.
+ */
+class SampleCatalog : private juce::Thread, private juce::AsyncUpdater {
+  public:
+    struct Listing {
+        // each sorted by name
+        juce::Array<juce::File> directories;
+        juce::Array<juce::File> files;
+        juce::Time modificationTime;
+    };
+
+    struct DrumKit {
+        struct Mapping {
+            int noteNumber;
+            juce::String fileName;
+        };
+
+        juce::String name;
+        juce::File mappingFile;
+        juce::Time modificationTime;
+        std::vector<Mapping> mappings;
+    };
+
+    SampleCatalog();
+    ~SampleCatalog() override;
+
+    /**
+     * Start scanning the libraries, does nothing if they are already the
+     * scanned ones
+     */
+    void setDirectories(const juce::File &samples, const juce::File &kits);
+    /**
+     * Directories the user edits, copied or linked into the scanned ones.
+     * They are watched instead of the scanned directories, a change calls
+     * `sync` with the changed source on the scanning thread before the
+     * scanned copy is listed again.
+     */
+    void setSources(const juce::File &samples, const juce::File &kits,
+                    std::function<void(const juce::File &)> sync);
+
+    /**
+     * Listing of a directory, read now if the scan hasn't reached it yet
+     */
+    Listing getListing(const juce::File &directory);
+    /**
+     * Drum kits sorted by name, only the ones found so far while the kits are
+     * scanned. Listeners are called once the scan of the kits is done.
+     */
+    std::vector<DrumKit> getDrumKits();
+    /**
+     * Kit of a mapping file, parsed now if it isn't in the catalog
+     */
+    std::optional<DrumKit> getDrumKit(const juce::File &mappingFile);
+
+    /**
+     * Parse a drum kit mapping file, returns nothing if it is invalid
+     */
+    static std::optional<DrumKit> readDrumKit(const juce::File &mappingFile);
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called on the message thread when files have been added, removed
+         * or modified
+         */
+        virtual void sampleCatalogChanged() {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+    static constexpr int pollIntervalMs = 2000;
+
+  private:
+    juce::CriticalSection catalogLock;
+    juce::File samplesDirectory;
+    juce::File drumKitsDirectory;
+    juce::File samplesSource;
+    juce::File drumKitsSource;
+    std::function<void(const juce::File &)> syncSource;
+    // keyed by full path
+    std::map<juce::String, Listing> listings;
+    std::map<juce::String, DrumKit> drumKits;
+
+    juce::ListenerList<Listener> listeners;
+
+    juce::SharedResourcePointer<WaveformCache> waveformCache;
+    // only used by the scanning thread
+    juce::Array<juce::File> filesWithoutPeaks;
+    bool isWatchingSources = false;
+
+#if JUCE_LINUX
+    int inotifyDescriptor = -1;
+    // only used by the scanning thread
+    std::map<int, juce::File> watchedDirectories;
+#endif
+    // watched by polling, keyed by full path, with the time of the directory
+    // followed by the times of its drum kit mapping files
+    std::map<juce::String, juce::Array<juce::Time>> polledDirectories;
+
+    void restart();
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    void scanDirectory(const juce::File &directory);
+    void rescanDirectory(const juce::File &directory);
+    void removeDirectory(const juce::File &directory);
+    void updateDrumKits(const juce::File &directory, const Listing &listing);
+    juce::Array<juce::File> waitForChanges();
+    void watch(const juce::File &directory);
+    void watchTree(const juce::File &directory);
+    void createPeaks();
+
+    static Listing readListing(const juce::File &directory);
+    static juce::Array<juce::Time> readPollTimes(const juce::File &directory);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleCatalog)
+};
+
+} // namespace app_services
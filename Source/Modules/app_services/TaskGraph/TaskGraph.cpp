@@ -0,0 +1,148 @@
+#include "TaskGraph.h"
+
+namespace app_services {
+
+TaskGraph::TaskGraph(const juce::String &name) : graphName(name) {}
+
+void TaskGraph::add(const juce::String &name, std::function<void()> task,
+                    const juce::StringArray &dependencies, RunOn runOn) {
+    tasks.push_back({name, std::move(task), dependencies, runOn});
+}
+
+bool TaskGraph::run() {
+    if (!isValid()) {
+        AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                               graphName + ": invalid task dependencies");
+        jassertfalse;
+        return false;
+    }
+
+    auto numBackgroundTasks =
+        std::count_if(tasks.begin(), tasks.end(), [](const Task &task) {
+            return task.runOn == RunOn::background;
+        });
+    juce::ThreadPool threadPool(juce::jlimit(
+        1, juce::SystemStats::getNumCpus(), int(numBackgroundTasks)));
+
+    {
+        const juce::ScopedLock sl(lock);
+        for (auto &task : tasks)
+            task.state = State::waiting;
+
+        timings.clear();
+        runStartMs = juce::Time::getMillisecondCounterHiRes();
+    }
+
+    for (;;) {
+        Task *callerTask = nullptr;
+        bool allFinished = true;
+
+        {
+            const juce::ScopedLock sl(lock);
+            for (auto &task : tasks) {
+                if (task.state != State::finished)
+                    allFinished = false;
+
+                if (task.state != State::waiting || !isReady(task))
+                    continue;
+
+                // every ready background task is started before running
+                // the next task of this thread
+                if (task.runOn == RunOn::background) {
+                    task.state = State::running;
+                    threadPool.addJob([this, &task] { runTask(task); });
+                } else if (callerTask == nullptr) {
+                    task.state = State::running;
+                    callerTask = &task;
+                }
+            }
+        }
+
+        if (allFinished)
+            break;
+
+        if (callerTask != nullptr)
+            runTask(*callerTask);
+        else
+            taskFinished.wait(-1);
+    }
+
+    juce::Logger::writeToLog(
+        graphName + ": finished in " +
+        juce::String(juce::Time::getMillisecondCounterHiRes() - runStartMs,
+                     1) +
+        " ms");
+    return true;
+}
+
+std::vector<TaskGraph::Timing> TaskGraph::getTimings() const {
+    const juce::ScopedLock sl(lock);
+    return timings;
+}
+
+bool TaskGraph::isValid() const {
+    juce::StringArray names;
+    for (const auto &task : tasks) {
+        if (names.contains(task.name))
+            return false;
+
+        names.add(task.name);
+    }
+
+    // resolve the tasks whose dependencies are resolved until none is left,
+    // the remaining ones depend on each other or on an unknown task
+    juce::StringArray resolved;
+    bool resolvedTask = true;
+
+    while (resolvedTask) {
+        resolvedTask = false;
+
+        for (const auto &task : tasks) {
+            if (resolved.contains(task.name))
+                continue;
+
+            bool isResolved = true;
+            for (const auto &dependency : task.dependencies)
+                isResolved = isResolved && resolved.contains(dependency);
+
+            if (isResolved) {
+                resolved.add(task.name);
+                resolvedTask = true;
+            }
+        }
+    }
+
+    return resolved.size() == int(tasks.size());
+}
+
+bool TaskGraph::isReady(const Task &task) const {
+    for (const auto &dependency : task.dependencies) {
+        auto found = std::find_if(
+            tasks.begin(), tasks.end(),
+            [&dependency](const Task &t) { return t.name == dependency; });
+        if (found == tasks.end() || found->state != State::finished)
+            return false;
+    }
+
+    return true;
+}
+
+void TaskGraph::runTask(Task &task) {
+    auto startMs = juce::Time::getMillisecondCounterHiRes();
+    task.function();
+    auto endMs = juce::Time::getMillisecondCounterHiRes();
+
+    AsyncFileLogger::write(AsyncFileLogger::Level::debug,
+                           graphName + ": " + task.name + " took " +
+                               juce::String(endMs - startMs, 1) + " ms");
+
+    {
+        const juce::ScopedLock sl(lock);
+        task.state = State::finished;
+        timings.push_back({task.name, startMs - runStartMs, endMs - startMs});
+    }
+
+    taskFinished.signal();
+}
+
+} // namespace app_services
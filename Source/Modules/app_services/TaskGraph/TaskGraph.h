@@ -0,0 +1,64 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Named tasks which run once the tasks they depend on have finished.
+ * Background tasks run in parallel on a thread pool, the others run in
+ * order on the thread calling run(). The time each task took is written to
+ * the log.
+ */
+class TaskGraph {
+  public:
+    enum class RunOn { caller, background };
+
+    explicit TaskGraph(const juce::String &name);
+
+    void add(const juce::String &name, std::function<void()> task,
+             const juce::StringArray &dependencies = {},
+             RunOn runOn = RunOn::caller);
+
+    /**
+     * Run every task and wait for them to finish. Returns false without
+     * running anything if a dependency is unknown or circular.
+     */
+    bool run();
+
+    struct Timing {
+        juce::String name;
+        // from the start of run()
+        double startMs = 0.0;
+        double durationMs = 0.0;
+    };
+
+    /**
+     * Timings of the tasks of the last run, in the order they finished
+     */
+    std::vector<Timing> getTimings() const;
+
+  private:
+    enum class State { waiting, running, finished };
+
+    struct Task {
+        juce::String name;
+        std::function<void()> function;
+        juce::StringArray dependencies;
+        RunOn runOn;
+        State state = State::waiting;
+    };
+
+    juce::String graphName;
+    std::vector<Task> tasks;
+
+    mutable juce::CriticalSection lock;
+    juce::WaitableEvent taskFinished;
+    std::vector<Timing> timings;
+    double runStartMs = 0.0;
+
+    bool isValid() const;
+    bool isReady(const Task &task) const;
+    void runTask(Task &task);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TaskGraph)
+};
+
+} // namespace app_services
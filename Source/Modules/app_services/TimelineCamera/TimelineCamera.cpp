@@ -4,11 +4,23 @@ namespace app_services {
 
 TimelineCamera::TimelineCamera(double scopeAmount) : scope(scopeAmount) {}
 
-void TimelineCamera::setScope(double s) { scope = s; }
+void TimelineCamera::setScope(double s) {
+    if (juce::exactlyEqual(scope, s))
+        return;
+
+    scope = s;
+    cameraChanged();
+}
 
 void TimelineCamera::setNudgeAmount(double nudge) { nudgeAmount = nudge; }
 
-void TimelineCamera::setCenter(double c) { center = c; }
+void TimelineCamera::setCenter(double c) {
+    if (juce::exactlyEqual(center, c))
+        return;
+
+    center = c;
+    cameraChanged();
+}
 
 void TimelineCamera::setCenterOffsetLimit(double col) {
     centerOffsetLimit = col;
@@ -22,9 +34,9 @@ double TimelineCamera::getCenter() { return center; }
 
 double TimelineCamera::getCenterOffsetLimit() { return centerOffsetLimit; }
 
-void TimelineCamera::nudgeCameraForward() { center += nudgeAmount; }
+void TimelineCamera::nudgeCameraForward() { setCenter(center + nudgeAmount); }
 
-void TimelineCamera::nudgeCameraBackward() { center -= nudgeAmount; }
+void TimelineCamera::nudgeCameraBackward() { setCenter(center - nudgeAmount); }
 
 double TimelineCamera::timeRelativeToCenter(double t) { return t - center; }
 
@@ -38,4 +50,12 @@ double TimelineCamera::timeToX(double t, double width) {
     return centerRelativeTimeToX(timeRelativeToCenter(t), width);
 }
 
+void TimelineCamera::addListener(Listener *l) { listeners.add(l); }
+
+void TimelineCamera::removeListener(Listener *l) { listeners.remove(l); }
+
+void TimelineCamera::cameraChanged() {
+    listeners.call([](Listener &l) { l.cameraChanged(); });
+}
+
 } // namespace app_services
\ No newline at end of file
@@ -28,6 +28,20 @@ class TimelineCamera {
 
     double timeToX(double t, double width);
 
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called when the center or the scope has changed, anything laid out
+         * with timeToX has to be laid out again
+         */
+        virtual void cameraChanged() {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
   private:
     // how much time is shown in the view
     double scope = 7;
@@ -43,9 +57,13 @@ class TimelineCamera {
     // exceeds this limit, we need to scroll the camera
     double centerOffsetLimit = (scope / 2.0) * .9;
 
+    juce::ListenerList<Listener> listeners;
+
     double timeRelativeToCenter(double t);
 
     double centerRelativeTimeToX(double timeRelativeToCenter, double width);
+
+    void cameraChanged();
 };
 
 } // namespace app_services
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "WaveformCache.h"
+
+namespace app_services {
+
+WaveformCache::WaveformCache() : juce::AudioThumbnailCache(maxThumbsInMemory) {
+    formatManager.registerBasicFormats();
+}
+
+WaveformCache::~WaveformCache() {
+    // the thread is stopped by the base class, after this one is gone
+    getTimeSliceThread().removeTimeSliceClient(this);
+    writePendingPeaks();
+}
+
+void WaveformCache::setDirectory(const juce::File &directory) {
+    directory.createDirectory();
+
+    {
+        const juce::ScopedLock lock(directoryLock);
+        if (peaksDirectory == directory)
+            return;
+
+        peaksDirectory = directory;
+        directorySize = -1;
+    }
+
+    // lists the directory and evicts peaks if it is over its limit
+    getTimeSliceThread().addTimeSliceClient(this);
+}
+
+juce::File WaveformCache::getDirectory() const {
+    const juce::ScopedLock lock(directoryLock);
+    return peaksDirectory;
+}
+
+bool WaveformCache::contains(const juce::File &file) const {
+    // every finished thumbnail is written to disk
+    return getPeaksFile(getHashCode(file)).existsAsFile();
+}
+
+bool WaveformCache::createPeaks(const juce::File &file) {
+    if (formatManager.findFormatForFileExtension(file.getFileExtension()) ==
+        nullptr)
+        return false;
+
+    auto hashCode = getHashCode(file);
+    auto peaksFile = getPeaksFile(hashCode);
+    if (peaksFile == juce::File() || peaksFile.existsAsFile())
+        return true;
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(file));
+    if (reader == nullptr)
+        return false;
+
+    juce::AudioThumbnail thumb(samplesPerThumbSample, formatManager, *this);
+    thumb.reset(int(reader->numChannels), reader->sampleRate,
+                reader->lengthInSamples);
+
+    // read in blocks so long samples aren't held in memory
+    const int blockSize = 64 * samplesPerThumbSample;
+    juce::AudioBuffer<float> buffer(int(reader->numChannels), blockSize);
+
+    for (juce::int64 position = 0; position < reader->lengthInSamples;
+         position += blockSize) {
+        auto numSamples = int(juce::jmin(juce::int64(blockSize),
+                                         reader->lengthInSamples - position));
+        reader->read(&buffer, 0, numSamples, position, true, true);
+        thumb.addBlock(position, buffer, 0, numSamples);
+    }
+
+    // already on a background thread
+    juce::MemoryOutputStream output;
+    thumb.saveTo(output);
+    writePeaks(output.getMemoryBlock(), hashCode);
+    return true;
+}
+
+juce::FileInputSource *
+WaveformCache::createInputSource(const juce::File &file) {
+    // the modification time is part of the hash, a modified file isn't
+    // drawn with stale peaks
+    return new juce::FileInputSource(file, true);
+}
+
+juce::int64 WaveformCache::getHashCode(const juce::File &file) {
+    return juce::FileInputSource(file, true).hashCode();
+}
+
+void WaveformCache::saveNewlyFinishedThumbnail(
+    const juce::AudioThumbnail &thumb, juce::int64 hashCode) {
+    if (!thumb.isFullyLoaded())
+        return;
+
+    // the thumbnail can be finished on the message thread, only the copy of
+    // its peaks is made there
+    juce::MemoryOutputStream output;
+    thumb.saveTo(output);
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        pendingPeaks.push_back({hashCode, output.getMemoryBlock()});
+    }
+
+    getTimeSliceThread().addTimeSliceClient(this);
+}
+
+bool WaveformCache::loadNewThumb(juce::AudioThumbnail &thumb,
+                                 juce::int64 hashCode) {
+    juce::FileInputStream input(getPeaksFile(hashCode));
+    if (!input.openedOk() || !thumb.loadFrom(input))
+        return false;
+
+    // touched from the cache thread, so recently used peaks are kept
+    {
+        const juce::ScopedLock lock(pendingLock);
+        usedPeaks.addIfNotAlreadyThere(hashCode);
+    }
+
+    getTimeSliceThread().addTimeSliceClient(this);
+    return true;
+}
+
+juce::File WaveformCache::getPeaksFile(juce::int64 hashCode) const {
+    const juce::ScopedLock lock(directoryLock);
+    if (peaksDirectory == juce::File())
+        return {};
+
+    return peaksDirectory.getChildFile(juce::String::toHexString(hashCode) +
+                                       ".peaks");
+}
+
+void WaveformCache::writePeaks(const juce::MemoryBlock &data,
+                               juce::int64 hashCode) {
+    auto peaksFile = getPeaksFile(hashCode);
+    if (peaksFile == juce::File())
+        return;
+
+    // written next to the peak file and moved, a reader never sees half of it
+    juce::TemporaryFile temporaryFile(peaksFile);
+
+    {
+        juce::FileOutputStream output(temporaryFile.getFile());
+        if (!output.openedOk())
+            return;
+
+        output.write(data.getData(), data.getSize());
+        output.flush();
+        if (output.getStatus().failed())
+            return;
+    }
+
+    if (!temporaryFile.overwriteTargetFileWithTemporary()) {
+        AsyncFileLogger::write(AsyncFileLogger::Level::error,
+                               "Unable to write waveform peaks to " +
+                                   peaksFile.getFullPathName());
+        return;
+    }
+
+    bool isOverLimit = false;
+
+    {
+        const juce::ScopedLock lock(directoryLock);
+        if (directorySize >= 0) {
+            directorySize += juce::int64(data.getSize());
+            isOverLimit = directorySize > maxDirectorySize;
+        }
+    }
+
+    if (isOverLimit)
+        getTimeSliceThread().addTimeSliceClient(this);
+}
+
+void WaveformCache::writePendingPeaks() {
+    std::vector<PendingPeaks> peaks;
+    juce::Array<juce::int64> used;
+
+    {
+        const juce::ScopedLock lock(pendingLock);
+        peaks.swap(pendingPeaks);
+        used.swapWith(usedPeaks);
+    }
+
+    for (const auto &pending : peaks)
+        writePeaks(pending.data, pending.hashCode);
+
+    auto now = juce::Time::getCurrentTime();
+    for (auto hashCode : used)
+        getPeaksFile(hashCode).setLastModificationTime(now);
+}
+
+void WaveformCache::evictPeaks() {
+    juce::File directory;
+
+    {
+        const juce::ScopedLock lock(directoryLock);
+        if (directorySize >= 0 && directorySize <= maxDirectorySize)
+            return;
+
+        directory = peaksDirectory;
+    }
+
+    if (directory == juce::File())
+        return;
+
+    std::vector<std::pair<juce::Time, juce::File>> files;
+    juce::int64 size = 0;
+
+    for (const auto &file :
+         directory.findChildFiles(juce::File::findFiles, false, "*.peaks")) {
+        files.emplace_back(file.getLastModificationTime(), file);
+        size += file.getSize();
+    }
+
+    // the least recently used first, down to three quarters of the limit so
+    // the next peaks don't evict again
+    if (size > maxDirectorySize) {
+        std::sort(files.begin(), files.end(),
+                  [](const auto &a, const auto &b) {
+                      return a.first < b.first;
+                  });
+
+        for (const auto &[time, file] : files) {
+            if (size <= maxDirectorySize / 4 * 3)
+                break;
+
+            auto fileSize = file.getSize();
+            if (file.deleteFile())
+                size -= fileSize;
+        }
+    }
+
+    const juce::ScopedLock lock(directoryLock);
+    if (peaksDirectory == directory)
+        directorySize = size;
+}
+
+int WaveformCache::useTimeSlice() {
+    writePendingPeaks();
+    evictPeaks();
+
+    // called again when there is something new to write
+    return -1;
+}
+
+} // namespace app_services
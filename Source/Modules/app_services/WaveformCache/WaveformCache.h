@@ -0,0 +1,84 @@
+#pragma once
+namespace app_services {
+
+/**
+ * Thumbnail cache which keeps the peaks of every sample on disk, so
+ * waveforms don't have to be read again in later sessions.
+ * Peak files are named after the hash of the file path and modification
+ * time, a modified sample gets new peaks. They are written from the cache
+ * thread, and the least recently used ones are deleted once the directory
+ * grows over its size limit. The most recently used thumbnails are also
+ * kept in memory.
+ *
+ * Use it through `juce::SharedResourcePointer<WaveformCache>`, thumbnails
+ * have to read their files through `createInputSource` so that their hash
+ * matches the peak files.
+ */
+class WaveformCache : public juce::AudioThumbnailCache,
+                      private juce::TimeSliceClient {
+  public:
+    WaveformCache();
+    ~WaveformCache() override;
+
+    /**
+     * Directory of the peak files, nothing is written until it is set
+     */
+    void setDirectory(const juce::File &directory);
+    juce::File getDirectory() const;
+
+    /**
+     * True if the peaks of the file are in memory or on disk
+     */
+    bool contains(const juce::File &file) const;
+    /**
+     * Read the file and write its peaks unless they already exist. Called
+     * from the thread scanning the samples, returns false if the file
+     * couldn't be read.
+     */
+    bool createPeaks(const juce::File &file);
+
+    /**
+     * Input source to give to a thumbnail of the file
+     */
+    static juce::FileInputSource *createInputSource(const juce::File &file);
+    static juce::int64 getHashCode(const juce::File &file);
+
+    static constexpr int samplesPerThumbSample = 512;
+    static constexpr int maxThumbsInMemory = 64;
+    static constexpr juce::int64 maxDirectorySize = 64 * 1024 * 1024;
+
+  protected:
+    void saveNewlyFinishedThumbnail(const juce::AudioThumbnail &thumb,
+                                    juce::int64 hashCode) override;
+    bool loadNewThumb(juce::AudioThumbnail &thumb,
+                      juce::int64 hashCode) override;
+
+  private:
+    struct PendingPeaks {
+        juce::int64 hashCode;
+        juce::MemoryBlock data;
+    };
+
+    mutable juce::CriticalSection directoryLock;
+    juce::File peaksDirectory;
+    // of the peak files, -1 until the directory has been listed
+    juce::int64 directorySize = -1;
+
+    // handed to the cache thread
+    juce::CriticalSection pendingLock;
+    std::vector<PendingPeaks> pendingPeaks;
+    juce::Array<juce::int64> usedPeaks;
+
+    // only used by createPeaks
+    juce::AudioFormatManager formatManager;
+
+    juce::File getPeaksFile(juce::int64 hashCode) const;
+    void writePeaks(const juce::MemoryBlock &data, juce::int64 hashCode);
+    void writePendingPeaks();
+    void evictPeaks();
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformCache)
+};
+
+} // namespace app_services
@@ -1,8 +1,44 @@
 // clang-format off
 #include "app_services.h"
 
+// AsyncFileLogger
+#include "AsyncFileLogger/AsyncFileLogger.cpp"
+
+// DrumKitLoader
+#include "DrumKitLoader/DrumKitLoader.cpp"
+
+// EditJournal
+#include "EditJournal/EditJournal.cpp"
+
+// EditRenderService
+#include "EditRenderService/EditRenderService.cpp"
+
+// EditSaveService
+#include "EditSaveService/EditSaveService.cpp"
+
+// FrameScheduler
+#include "FrameScheduler/FrameScheduler.cpp"
+
 // MidiCommandManager
 #include "MidiCommandManager/MidiCommandManager.cpp"
 
+// PeakCache
+#include "PeakCache/PeakCache.cpp"
+
+// ProjectFile
+#include "ProjectFile/ProjectFile.cpp"
+
+// ProjectIndex
+#include "ProjectIndex/ProjectIndex.cpp"
+
+// SampleCatalog
+#include "SampleCatalog/SampleCatalog.cpp"
+
+// TaskGraph
+#include "TaskGraph/TaskGraph.cpp"
+
 // TimelineCamera
-#include "TimelineCamera/TimelineCamera.cpp"
\ No newline at end of file
+#include "TimelineCamera/TimelineCamera.cpp"
+
+// WaveformCache
+#include "WaveformCache/WaveformCache.cpp"
\ No newline at end of file
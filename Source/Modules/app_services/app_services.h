@@ -16,8 +16,20 @@
 
 namespace app_services {
 
+    class AsyncFileLogger;
+    class DrumKitLoader;
+    class EditJournal;
+    class EditRenderService;
+    class EditSaveService;
+    class FrameScheduler;
     class MidiCommandManager;
+    class PeakCache;
+    class ProjectFile;
+    class ProjectIndex;
+    class SampleCatalog;
+    class TaskGraph;
     class TimelineCamera;
+    class WaveformCache;
 
 }
 
@@ -25,12 +37,53 @@ namespace app_services {
 #include <juce_events/juce_events.h>
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
+#include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <map>
+#include <optional>
+
+// AsyncFileLogger
+#include "AsyncFileLogger/AsyncFileLogger.h"
+
+// DrumKitLoader
+#include "DrumKitLoader/DrumKitLoader.h"
+
+// EditRenderService
+#include "EditRenderService/EditRenderService.h"
+
+// EditSaveService
+#include "EditSaveService/EditSaveService.h"
+
+// EditJournal
+#include "EditJournal/EditJournal.h"
+
+// FrameScheduler
+#include "FrameScheduler/FrameScheduler.h"
 
 // MidiCommandManager
 #include "MidiCommandManager/MidiCommandManager.h"
 
+// PeakCache
+#include "PeakCache/PeakCache.h"
+
+// ProjectFile
+#include "ProjectFile/ProjectFile.h"
+
+// ProjectIndex
+#include "ProjectIndex/ProjectIndex.h"
+
+// WaveformCache
+#include "WaveformCache/WaveformCache.h"
+
+// SampleCatalog
+#include "SampleCatalog/SampleCatalog.h"
+
+// TaskGraph
+#include "TaskGraph/TaskGraph.h"
+
 
 // TimelineCamera
 #include "TimelineCamera/TimelineCamera.h"
@@ -44,8 +44,7 @@ int EditViewModel::getCurrentOctave() const { return currentOctave.get(); }
 
 void EditViewModel::setCurrentOctave(int octave) {
     currentOctave.setValue(octave, nullptr);
-    tracktion::EditFileOperations fileOperations(edit);
-    fileOperations.save(true, true, false);
+    saveService->requestSave(edit);
 }
 
 void EditViewModel::valueTreePropertyChanged(
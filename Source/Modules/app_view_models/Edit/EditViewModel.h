@@ -29,6 +29,7 @@ class EditViewModel : public juce::ValueTree::Listener,
     const int MIN_OCTAVE = -4;
     const int MAX_OCTAVE = 4;
     tracktion::Edit &edit;
+    juce::SharedResourcePointer<app_services::EditSaveService> saveService;
     // this is the EDIT_VIEW_STATE value tree that is a child of the edit
     // value tree
     juce::ValueTree state;
@@ -23,44 +23,46 @@ float ADSRViewModel::getRelease() const {
     return plugin->ampRelease->getCurrentNormalisedValue();
 }
 
-void ADSRViewModel::incrementAttack() {
-    plugin->ampAttack->setNormalisedParameter(getAttack() + 0.01f,
-                                              juce::dontSendNotification);
-}
+void ADSRViewModel::incrementAttack() { changeAttack(1); }
 
-void ADSRViewModel::decrementAttack() {
-    plugin->ampAttack->setNormalisedParameter(getAttack() - 0.01f,
-                                              juce::dontSendNotification);
-}
+void ADSRViewModel::decrementAttack() { changeAttack(-1); }
 
-void ADSRViewModel::incrementDecay() {
-    plugin->ampDecay->setNormalisedParameter(getDecay() + 0.01f,
-                                             juce::dontSendNotification);
-}
+void ADSRViewModel::incrementDecay() { changeDecay(1); }
+
+void ADSRViewModel::decrementDecay() { changeDecay(-1); }
+
+void ADSRViewModel::incrementSustain() { changeSustain(1); }
 
-void ADSRViewModel::decrementDecay() {
-    plugin->ampDecay->setNormalisedParameter(getDecay() - 0.01f,
-                                             juce::dontSendNotification);
+void ADSRViewModel::decrementSustain() { changeSustain(-1); }
+
+void ADSRViewModel::incrementRelease() { changeRelease(1); }
+
+void ADSRViewModel::decrementRelease() { changeRelease(-1); }
+
+void ADSRViewModel::changeAttack(int steps) {
+    changeParameter(*plugin->ampAttack, steps);
 }
 
-void ADSRViewModel::incrementSustain() {
-    plugin->ampSustain->setNormalisedParameter(getSustain() + 0.01f,
-                                               juce::dontSendNotification);
+void ADSRViewModel::changeDecay(int steps) {
+    changeParameter(*plugin->ampDecay, steps);
 }
 
-void ADSRViewModel::decrementSustain() {
-    plugin->ampSustain->setNormalisedParameter(getSustain() - 0.01f,
-                                               juce::dontSendNotification);
+void ADSRViewModel::changeSustain(int steps) {
+    changeParameter(*plugin->ampSustain, steps);
 }
 
-void ADSRViewModel::incrementRelease() {
-    plugin->ampRelease->setNormalisedParameter(getRelease() + 0.01f,
-                                               juce::dontSendNotification);
+void ADSRViewModel::changeRelease(int steps) {
+    changeParameter(*plugin->ampRelease, steps);
 }
 
-void ADSRViewModel::decrementRelease() {
-    plugin->ampRelease->setNormalisedParameter(getRelease() - 0.01f,
-                                               juce::dontSendNotification);
+void ADSRViewModel::changeParameter(
+    tracktion::AutomatableParameter &parameter, int steps) {
+    if (steps == 0)
+        return;
+
+    parameter.setNormalisedParameter(parameter.getCurrentNormalisedValue() +
+                                         stepSize * float(steps),
+                                     juce::dontSendNotification);
 }
 
 void ADSRViewModel::handleAsyncUpdate() {
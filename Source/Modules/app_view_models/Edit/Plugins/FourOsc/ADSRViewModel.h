@@ -23,6 +23,15 @@ class ADSRViewModel : public juce::ValueTree::Listener,
     void incrementRelease();
     void decrementRelease();
 
+    /**
+     * Move a parameter by a number of 0.01 steps with a single write,
+     * negative steps decrease it.
+     */
+    void changeAttack(int steps);
+    void changeDecay(int steps);
+    void changeSustain(int steps);
+    void changeRelease(int steps);
+
     class Listener {
       public:
         virtual ~Listener() = default;
@@ -39,6 +48,10 @@ class ADSRViewModel : public juce::ValueTree::Listener,
   private:
     tracktion::FourOscPlugin *plugin;
 
+    static constexpr float stepSize = 0.01f;
+    static void changeParameter(tracktion::AutomatableParameter &parameter,
+                                int steps);
+
     juce::ListenerList<Listener> listeners;
 
     void handleAsyncUpdate() override;
@@ -3,18 +3,17 @@ namespace app_view_models {
 
 DrumSamplerViewModel::DrumSamplerViewModel(
     internal_plugins::DrumSamplerPlugin *sampler)
-    : SamplerViewModel(sampler, IDs::DRUM_SAMPLER_VIEW_STATE) {
+    : SamplerViewModel(sampler, IDs::DRUM_SAMPLER_VIEW_STATE),
+      kitLoader(sampler->engine) {
     updateDrumKits();
-    itemListState.listSize = drumKits.size();
+    itemListState.listSize = int(drumKits.size());
 
-    if (drumKits.size() > 0) {
+    if (!drumKits.empty()) {
         DBG("current kit index: " +
             std::to_string(itemListState.getSelectedItemIndex()));
         juce::File currentMap =
-            drumKits[itemListState.getSelectedItemIndex()].mappingFile;
-        readMappingFileIntoSampler(currentMap, true);
-        DBG("updating thumb");
-        updateThumb();
+            drumKits[size_t(itemListState.getSelectedItemIndex())].mappingFile;
+        loadKit(currentMap, false);
     }
 }
 
@@ -36,12 +35,24 @@ void DrumSamplerViewModel::setSelectedSoundIndex(int noteNumber) {
 }
 
 void DrumSamplerViewModel::selectedIndexChanged(int newIndex) {
+    if (!juce::isPositiveAndBelow(newIndex, int(drumKits.size())))
+        return;
+
     // we just changed kits
-    juce::File newMapFile = drumKits[newIndex].mappingFile;
-    readMappingFileIntoSampler(newMapFile, true);
-    selectedSoundIndex.setValue(0, nullptr);
-    markAndUpdate(shouldUpdateGain);
-    updateThumb();
+    juce::File newMapFile = drumKits[size_t(newIndex)].mappingFile;
+    loadKit(newMapFile, true);
+}
+
+void DrumSamplerViewModel::sampleCatalogChanged() {
+    updateDrumKits();
+    itemListState.listSize = int(drumKits.size());
+    markAndUpdate(shouldUpdateItems);
+
+    // the kits hadn't been scanned yet when the view model was created
+    auto index = itemListState.getSelectedItemIndex();
+    if (drumSampleFiles.isEmpty() && !kitLoader.isLoading() &&
+        juce::isPositiveAndBelow(index, int(drumKits.size())))
+        loadKit(drumKits[size_t(index)].mappingFile, false);
 }
 
 void DrumSamplerViewModel::valueTreePropertyChanged(
@@ -57,29 +68,38 @@ void DrumSamplerViewModel::valueTreePropertyChanged(
     }
 }
 
-void DrumSamplerViewModel::readMappingFileIntoSampler(
-    const juce::File &mappingFile, bool shouldUpdateSounds) {
-    drumSampleFiles.clear();
-    for (int i = 0; i < samplerPlugin->getNumSounds(); i++) {
-        samplerPlugin->removeSound(i);
-    }
+void DrumSamplerViewModel::loadKit(const juce::File &mappingFile,
+                                   bool shouldResetSelection) {
+    // the previous kit keeps playing until this one is ready, a kit
+    // selected in the meantime replaces it
+    kitLoader.load(getKitSounds(mappingFile),
+                   [this, shouldResetSelection](const auto &sounds) {
+                       readKitIntoSampler(sounds, true);
+
+                       if (shouldResetSelection)
+                           selectedSoundIndex.setValue(0, nullptr);
+
+                       markAndUpdate(shouldUpdateGain);
+                       updateThumb();
+                   });
+}
+
+std::vector<app_services::DrumKitLoader::Sound>
+DrumSamplerViewModel::getKitSounds(const juce::File &mappingFile) {
+    std::vector<app_services::DrumKitLoader::Sound> sounds;
+
+    // the mapping was parsed when the catalog found the kit
+    auto kit = sampleCatalog->getDrumKit(mappingFile);
+    if (!kit.has_value())
+        return sounds;
 
-    YAML::Node rootNode =
-        YAML::LoadFile(mappingFile.getFullPathName().toStdString());
     const auto kitDir =
         samplerPlugin->edit.engine.getTemporaryFileManager().getTempFile(
             ConfigurationHelpers::DRUM_KITS_DIRECTORY_NAME);
-    YAML::Node mappings = rootNode["mappings"];
-    assert(mappings.IsSequence());
-    auto foundDirs =
-        kitDir.findChildFiles(juce::File::TypesOfFileToFind::findDirectories,
-                              false, mappingFile.getFileNameWithoutExtension());
-    bool isUserMap = foundDirs.size() > 0;
-    for (std::size_t i = 0; i < mappings.size(); i++) {
-        YAML::Node mapping = mappings[i];
-        int noteNumber = mapping["note_number"].as<int>();
-        juce::String fileName = mapping["file_name"].as<std::string>();
-
+    bool isUserMap =
+        kitDir.getChildFile(mappingFile.getFileNameWithoutExtension())
+            .isDirectory();
+    for (const auto &mapping : kit->mappings) {
         // First check if a directory with the same name as the mapping file
         // exists in the drum_kits dir
         juce::File file;
@@ -91,10 +111,25 @@ void DrumSamplerViewModel::readMappingFileIntoSampler(
             // resides in
             file =
                 kitDir.getChildFile(mappingFile.getFileNameWithoutExtension())
-                    .getChildFile(fileName);
+                    .getChildFile(mapping.fileName);
         } else {
-            file = kitDir.getChildFile(fileName);
+            file = kitDir.getChildFile(mapping.fileName);
         }
+
+        sounds.push_back({file, mapping.noteNumber});
+    }
+
+    return sounds;
+}
+
+void DrumSamplerViewModel::readKitIntoSampler(
+    const std::vector<app_services::DrumKitLoader::Sound> &sounds,
+    bool shouldUpdateSounds) {
+    // every change is made before the sampler rebuilds its sounds, which
+    // then replace the previous kit at once
+    drumSampleFiles.clear();
+    for (const auto &sound : sounds) {
+        const auto &file = sound.file;
         drumSampleFiles.add(file);
 
         // check if the drum sampler has enough sounds to cover this index:
@@ -109,56 +144,27 @@ void DrumSamplerViewModel::readMappingFileIntoSampler(
         }
         samplerPlugin->setSoundMedia(index, file.getFullPathName());
         if (shouldUpdateSounds) {
-            samplerPlugin->setSoundParams(index, noteNumber, noteNumber,
-                                          noteNumber);
+            samplerPlugin->setSoundParams(index, sound.noteNumber,
+                                          sound.noteNumber, sound.noteNumber);
             samplerPlugin->setSoundGains(index, 1, 0);
-            samplerPlugin->setSoundExcerpt(
-                index, 0,
-                tracktion::AudioFile(samplerPlugin->engine, file).getLength());
+            samplerPlugin->setSoundExcerpt(index, 0, sound.length);
             samplerPlugin->setSoundOpenEnded(index, true);
         }
     }
+
+    // sounds of the previous kit that this one doesn't replace
+    for (int i = samplerPlugin->getNumSounds() - 1;
+         i >= drumSampleFiles.size(); i--)
+        samplerPlugin->removeSound(i);
 }
 
 void DrumSamplerViewModel::updateDrumKits() {
-    drumKits.clear();
-    const auto sampleDir = ConfigurationHelpers::getTempDrumKitsDirectory(
-        samplerPlugin->edit.engine);
-    // find all yaml files recursively
-    for (juce::DirectoryEntry entry : juce::RangedDirectoryIterator(
-             sampleDir, true, "*.yaml",
-             juce::File::TypesOfFileToFind::findFiles)) {
-        YAML::Node node =
-            YAML::LoadFile(entry.getFile().getFullPathName().toStdString());
-
-        if (!node.IsNull()) {
-            // file seems valid, build a drumkit entry
-            DrumKitEntry entryData;
-            entryData.name = node["name"].as<std::string>();
-            entryData.mappingFile = entry.getFile();
-            drumKits.add(entryData);
-        } else {
-            juce::Logger::writeToLog(
-                "unable to read YAML file: " +
-                entry.getFile().getFullPathName().toStdString());
-        }
-    }
-    // sort alphabetically
-    std::sort(drumKits.begin(), drumKits.end());
+    // every yaml file of the drum kits directory, sorted alphabetically
+    drumKits = sampleCatalog->getDrumKits();
 }
 
 void DrumSamplerViewModel::updateThumb() {
-    auto file = drumSampleFiles[selectedSoundIndex];
-    auto *reader = formatManager.createReaderFor(file);
-    if (reader != nullptr) {
-        std::unique_ptr<juce::AudioFormatReaderSource> newSource(
-            new juce::AudioFormatReaderSource(reader, true));
-        fullSampleThumbnail.clear();
-        fullSampleThumbnailCache.clear();
-        fullSampleThumbnail.setSource(new juce::FileInputSource(file));
-        readerSource.reset(newSource.release());
-    }
-
+    setThumbnail(drumSampleFiles[selectedSoundIndex]);
     markAndUpdate(shouldUpdateSample);
 }
 } // namespace app_view_models
@@ -1,19 +1,8 @@
-#include <yaml-cpp/yaml.h>
 namespace app_view_models {
 namespace IDs {
 const juce::Identifier DRUM_SAMPLER_VIEW_STATE("DRUM_SAMPLER_VIEW_STATE");
 }
 
-struct DrumKitEntry {
-    juce::String name;
-    juce::File mappingFile;
-
-    // Optional: Allow sorting by name
-    bool operator<(const DrumKitEntry &other) const {
-        return name.compareIgnoreCase(other.name) < 0;
-    }
-};
-
 class DrumSamplerViewModel : public app_view_models::SamplerViewModel {
   public:
     explicit DrumSamplerViewModel(internal_plugins::DrumSamplerPlugin *sampler);
@@ -27,16 +16,23 @@ class DrumSamplerViewModel : public app_view_models::SamplerViewModel {
     void setSelectedSoundIndex(int noteNumber) override;
 
     void selectedIndexChanged(int newIndex) override;
+    void sampleCatalogChanged() override;
 
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
                                   const juce::Identifier &property) override;
 
   private:
-    juce::Array<DrumKitEntry> drumKits;
+    // sorted by name
+    std::vector<app_services::SampleCatalog::DrumKit> drumKits;
     juce::Array<juce::File> drumSampleFiles;
-
-    void readMappingFileIntoSampler(const juce::File &mappingFile,
-                                    bool shouldUpdateSounds);
+    app_services::DrumKitLoader kitLoader;
+
+    void loadKit(const juce::File &mappingFile, bool shouldResetSelection);
+    std::vector<app_services::DrumKitLoader::Sound>
+    getKitSounds(const juce::File &mappingFile);
+    void readKitIntoSampler(
+        const std::vector<app_services::DrumKitLoader::Sound> &sounds,
+        bool shouldUpdateSounds);
     void updateDrumKits();
     void updateThumb();
 };
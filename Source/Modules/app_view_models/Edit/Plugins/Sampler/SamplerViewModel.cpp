@@ -6,11 +6,16 @@ SamplerViewModel::SamplerViewModel(tracktion::SamplerPlugin *sampler,
     : samplerPlugin(sampler),
       state(samplerPlugin->edit.state.getOrCreateChildWithName(stateIdentifier,
                                                                nullptr)),
-      itemListState(state, 100), fullSampleThumbnailCache(5),
+      itemListState(state, 100),
       fullSampleThumbnail(numSamplesForThumbnail, formatManager,
-                          fullSampleThumbnailCache) {
+                          *waveformCache) {
     formatManager.registerBasicFormats();
     selectedSoundIndex.referTo(state, IDs::selectedSoundIndex, nullptr, 0);
+    waveformCache->setDirectory(ConfigurationHelpers::getWaveformsDirectory());
+    sampleCatalog->setDirectories(
+        ConfigurationHelpers::getTempSamplesDirectory(samplerPlugin->engine),
+        ConfigurationHelpers::getTempDrumKitsDirectory(samplerPlugin->engine));
+    sampleCatalog->addListener(this);
     samplerPlugin->state.addListener(this);
     fullSampleThumbnail.addChangeListener(this);
     itemListState.addListener(this);
@@ -18,6 +23,7 @@ SamplerViewModel::SamplerViewModel(tracktion::SamplerPlugin *sampler,
 }
 
 SamplerViewModel::~SamplerViewModel() {
+    sampleCatalog->removeListener(this);
     samplerPlugin->state.removeListener(this);
     itemListState.removeListener(this);
     state.removeListener(this);
@@ -154,6 +160,14 @@ void SamplerViewModel::handleAsyncUpdate() {
 
     if (compareAndReset(shouldUpdateGain))
         listeners.call([this](Listener &l) { l.gainChanged(); });
+
+    if (compareAndReset(shouldUpdateItems))
+        listeners.call([this](Listener &l) { l.itemsChanged(); });
+}
+
+void SamplerViewModel::setThumbnail(const juce::File &file) {
+    fullSampleThumbnail.setSource(
+        app_services::WaveformCache::createInputSource(file));
 }
 
 void SamplerViewModel::changeListenerCallback(juce::ChangeBroadcaster *source) {
@@ -9,6 +9,7 @@ const juce::Identifier selectedSoundIndex("selectedSoundIndex");
 class SamplerViewModel : public juce::ChangeListener,
                          public juce::ValueTree::Listener,
                          public app_view_models::ItemListState::Listener,
+                         public app_services::SampleCatalog::Listener,
                          public FlaggedAsyncUpdater {
   public:
     explicit SamplerViewModel(tracktion::SamplerPlugin *sampler,
@@ -61,22 +62,24 @@ class SamplerViewModel : public juce::ChangeListener,
         virtual void fullSampleThumbnailChanged() {}
         virtual void sampleExcerptThumbnailChanged() {}
         virtual void gainChanged() {}
+        virtual void itemsChanged() {}
     };
 
     void addListener(Listener *l);
     void removeListener(Listener *l);
 
   protected:
-    const int numSamplesForThumbnail = 512;
+    const int numSamplesForThumbnail =
+        app_services::WaveformCache::samplesPerThumbSample;
     tracktion::SamplerPlugin *samplerPlugin;
+    juce::SharedResourcePointer<app_services::SampleCatalog> sampleCatalog;
 
     juce::ValueTree state;
     juce::CachedValue<int> selectedSoundIndex;
 
     juce::AudioFormatManager formatManager;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
 
-    juce::AudioThumbnailCache fullSampleThumbnailCache;
+    juce::SharedResourcePointer<app_services::WaveformCache> waveformCache;
     juce::AudioThumbnail fullSampleThumbnail;
 
     juce::ListenerList<Listener> listeners;
@@ -85,9 +88,16 @@ class SamplerViewModel : public juce::ChangeListener,
     bool shouldUpdateSampleExcerptTimes = false;
     bool shouldUpdateSample = false;
     bool shouldUpdateGain = false;
+    bool shouldUpdateItems = false;
 
     void handleAsyncUpdate() override;
 
+    /**
+     * Show the file in the full sample thumbnail, drawn from its peak file.
+     * If it has none yet, the peaks are read from the file in the background.
+     */
+    void setThumbnail(const juce::File &file);
+
   public:
     ItemListState itemListState;
 };
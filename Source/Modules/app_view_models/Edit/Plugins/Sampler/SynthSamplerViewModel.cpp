@@ -9,17 +9,13 @@ SynthSamplerViewModel::SynthSamplerViewModel(tracktion::SamplerPlugin *sampler)
         // first time initialization
         curDir = ConfigurationHelpers::getTempSamplesDirectory(
             samplerPlugin->edit.engine);
-        juce::Array<juce::File> found_files = curDir.findChildFiles(
-            juce::File::TypesOfFileToFind::findFiles, false);
-        // Sort by file name (ascending)
-        found_files.sort();
-        curFile = found_files[0];
+        // sorted by file name (ascending)
+        curFile = sampleCatalog->getListing(curDir).files[0];
         curFilePath.setValue(curFile.getFullPathName(), nullptr);
     } else if (curFile.isDirectory()) {
         // curFile should never be a directory, but just in case
         curDir = curFile;
-        curFile = curDir.findChildFiles(
-            juce::File::TypesOfFileToFind::findFiles, false)[0];
+        curFile = sampleCatalog->getListing(curDir).files[0];
         curFilePath.setValue(curFile.getFullPathName(), nullptr);
     } else {
         curDir = curFile.getParentDirectory();
@@ -43,16 +39,10 @@ void SynthSamplerViewModel::updateFiles() {
         auto parent = curDir.getChildFile("..");
         files.add(parent);
     }
-    juce::Array<juce::File> found_files =
-        curDir.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false);
-    // Sort by file name (ascending)
-    found_files.sort();
-    juce::Array<juce::File> found_dirs = curDir.findChildFiles(
-        juce::File::TypesOfFileToFind::findDirectories, false);
-    // Sort by file name (ascending)
-    found_dirs.sort();
-    files.addArray(found_dirs);
-    files.addArray(found_files);
+    // both sorted by file name (ascending)
+    auto listing = sampleCatalog->getListing(curDir);
+    files.addArray(listing.directories);
+    files.addArray(listing.files);
 }
 
 juce::StringArray SynthSamplerViewModel::getItemNames() {
@@ -101,16 +91,7 @@ void SynthSamplerViewModel::enterDir() {
 
 void SynthSamplerViewModel::updateThumb() {
     auto curFile = juce::File(curFilePath);
-    auto *reader = formatManager.createReaderFor(curFile);
-    if (reader != nullptr) {
-        std::unique_ptr<juce::AudioFormatReaderSource> newSource(
-            new juce::AudioFormatReaderSource(reader, true));
-        fullSampleThumbnail.clear();
-        fullSampleThumbnailCache.clear();
-        fullSampleThumbnail.setSource(new juce::FileInputSource(curFile));
-        readerSource.reset(newSource.release());
-    }
-
+    setThumbnail(curFile);
     markAndUpdate(shouldUpdateFullSampleThumbnail);
 }
 
@@ -146,6 +127,12 @@ void SynthSamplerViewModel::selectedIndexChanged(int newIndex) {
     markAndUpdate(shouldUpdateSample);
 }
 
+void SynthSamplerViewModel::sampleCatalogChanged() {
+    updateFiles();
+    itemListState.listSize = files.size();
+    markAndUpdate(shouldUpdateItems);
+}
+
 void SynthSamplerViewModel::valueTreePropertyChanged(
     juce::ValueTree &treeWhosePropertyHasChanged,
     const juce::Identifier &property) {
@@ -20,6 +20,7 @@ class SynthSamplerViewModel : public app_view_models::SamplerViewModel {
     juce::String getSelectedItemName() override;
 
     void selectedIndexChanged(int newIndex) override;
+    void sampleCatalogChanged() override;
 
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
                                   const juce::Identifier &property) override;
@@ -68,6 +68,10 @@ StepSequencerViewModel::StepSequencerViewModel(tracktion::AudioTrack::Ptr t)
     DBG("clip starts at " + std::to_string(midiClipStart.inSeconds()));
     DBG("clip ends at " + std::to_string(midiClipEnd.inSeconds()));
 
+    dirtySteps.resize(size_t(getNumChannels()), 0);
+    sequenceState = midiClip->getSequence().state;
+    sequenceState.addListener(this);
+
     generateStepSequenceFromMidi();
 
     // --------------------------
@@ -105,8 +109,7 @@ StepSequencerViewModel::StepSequencerViewModel(tracktion::AudioTrack::Ptr t)
     numberOfNotes.setValue(defaultNbNotes, nullptr);
     // --------------------------
 
-    // resync midi clip sequence with patterns
-    generateMidiSequence();
+    // the midi clip sequence is resynced with patterns on the first sync
 
     loopAroundClip(*midiClip);
 
@@ -116,7 +119,8 @@ StepSequencerViewModel::StepSequencerViewModel(tracktion::AudioTrack::Ptr t)
 StepSequencerViewModel::~StepSequencerViewModel() {
     stop();
 
-    generateMidiSequence();
+    syncMidiSequence();
+    sequenceState.removeListener(this);
 
     // if the sequence is empty, delete the clip
     // and disable looping
@@ -242,7 +246,7 @@ int StepSequencerViewModel::getNumNotesPerChannel() {
 }
 
 int StepSequencerViewModel::noteIntensityAt(int channel, int noteIndex) {
-    return stepSequence.getChannel(channel)->getNote(noteIndex);
+    return stepSequence.getNote(channel, noteIndex);
 }
 
 // TODO: refactor with toggleNote(index, channel)
@@ -273,16 +277,12 @@ void StepSequencerViewModel::toggleNoteNumberAtSelectedIndex(int noteNumber) {
         nextIntensity = 0;
     }
 
-    stepSequence.getChannel(channel)->setNote(selectedNoteIndex.get(),
-                                              nextIntensity);
+    stepSequence.setNote(channel, selectedNoteIndex.get(), nextIntensity);
+    markStepDirty(channel, selectedNoteIndex.get());
 
     if (isPlaying) {
         // When looping also add or remove note from the midi sequence to hear
-        if (nextIntensity == 0) {
-            removeNoteFromSequence(channel, selectedNoteIndex.get());
-        } else {
-            addNoteToSequence(channel, selectedNoteIndex.get(), nextIntensity);
-        }
+        requestMidiSync();
     }
 }
 
@@ -360,6 +360,8 @@ void StepSequencerViewModel::incrementNotesPerMeasure() {
 
             int nextValue = notesPerMeasureOptions[newIndex];
 
+            // keep pending changes before the pattern is recomputed
+            syncMidiSequence();
             notesPerMeasure.setValue(nextValue, nullptr);
 
             // compute the new number of notes for the measure division
@@ -388,6 +390,8 @@ void StepSequencerViewModel::decrementNotesPerMeasure() {
             else
                 newIndex = currentIndex - 1;
 
+            // keep pending changes before the pattern is recomputed
+            syncMidiSequence();
             notesPerMeasure.setValue(notesPerMeasureOptions[newIndex], nullptr);
             // compute the new number of notes for the measure division
             float prevNbMeasures =
@@ -404,10 +408,14 @@ void StepSequencerViewModel::decrementNotesPerMeasure() {
 }
 
 void StepSequencerViewModel::clearNotesAtSelectedIndex() {
+    beginEdit();
+
     for (int i = 0; i < app_models::StepChannel::maxNumberOfChannels; i++) {
-        stepSequence.getChannel(i)->setNote(selectedNoteIndex, false);
-        removeNoteFromSequence(i, selectedNoteIndex);
+        stepSequence.setNote(i, selectedNoteIndex.get(), 0);
+        markStepDirty(i, selectedNoteIndex.get());
     }
+
+    commitEdit();
 }
 
 void StepSequencerViewModel::play() {
@@ -416,7 +424,7 @@ void StepSequencerViewModel::play() {
     // though. https://forum.juce.com/t/how-to-render-a-midiclip-any-hints/31004
     // https://forum.juce.com/t/createeditforpreviewingclip-how-is-it-used/32757/11
     if (!track->edit.getTransport().isPlaying()) {
-        generateMidiSequence();
+        syncMidiSequence();
         track->edit.clickTrackEnabled.setValue(false, nullptr);
         track->setSolo(true);
         track->edit.getTransport().play(false);
@@ -483,21 +491,41 @@ void StepSequencerViewModel::pasteSelection() {
     }
 
     DBG("Pasting selection");
+    beginEdit();
     int from = getSelectedNoteIndex();
     for (int noteIndex = 0; noteIndex < copiedNotes.size(); noteIndex++) {
         int velocity = noteIntensityAt(copiedNotes[noteIndex].channel,
                                        copiedNotes[noteIndex].index);
-        addNoteToSequence(copiedNotes[noteIndex].channel,
-                          from + copiedNotes[noteIndex].index, velocity);
-
-        stepSequence.getChannel(copiedNotes[noteIndex].channel)
-            ->setNote(from + copiedNotes[noteIndex].index, velocity);
+        stepSequence.setNote(copiedNotes[noteIndex].channel,
+                             from + copiedNotes[noteIndex].index, velocity);
+        markStepDirty(copiedNotes[noteIndex].channel,
+                      from + copiedNotes[noteIndex].index);
 
         DBG("Pasted note, index " +
             std::to_string(from + copiedNotes[noteIndex].index) + " channel " +
             std::to_string(copiedNotes[noteIndex].channel) + " velocity " +
             std::to_string(velocity));
     }
+
+    commitEdit();
+}
+
+void StepSequencerViewModel::beginEdit() { editDepth++; }
+
+void StepSequencerViewModel::commitEdit() {
+    jassert(editDepth > 0);
+
+    if (--editDepth > 0)
+        return;
+
+    // write patterns now so listeners get a single pattern change
+    stepSequence.flush();
+    syncMidiSequence();
+}
+
+void StepSequencerViewModel::requestMidiSync() {
+    if (editDepth == 0)
+        syncMidiSequence();
 }
 
 void StepSequencerViewModel::handleAsyncUpdate() {
@@ -582,6 +610,24 @@ void StepSequencerViewModel::valueTreePropertyChanged(
             // nothing
         }
     }
+
+    // a note of the midi clip has been changed from outside
+    if (!isSyncingSequence &&
+        treeWhosePropertyHasChanged.getParent() == sequenceState)
+        sequenceNotesAreValid = false;
+}
+
+void StepSequencerViewModel::valueTreeChildAdded(
+    juce::ValueTree &parentTree, juce::ValueTree & /*childWhichHasBeenAdded*/) {
+    if (!isSyncingSequence && parentTree == sequenceState)
+        sequenceNotesAreValid = false;
+}
+
+void StepSequencerViewModel::valueTreeChildRemoved(
+    juce::ValueTree &parentTree, juce::ValueTree & /*childWhichHasBeenRemoved*/,
+    int /*indexFromWhichChildWasRemoved*/) {
+    if (!isSyncingSequence && parentTree == sequenceState)
+        sequenceNotesAreValid = false;
 }
 
 void StepSequencerViewModel::addListener(Listener *l) {
@@ -632,17 +678,26 @@ void StepSequencerViewModel::generateStepSequenceFromMidi() {
             int intensity = computeNoteIntensity(note);
             int channelIdx = noteNumberToChannel(noteNumber);
 
-            stepSequence.getChannel(channelIdx)->setNote(index, intensity);
+            stepSequence.setNote(channelIdx, int(index), intensity);
         }
     }
+
+    // patterns and midi clip are in sync, notes that were rounded to a step
+    // are detected when the note index is rebuilt
+    std::fill(dirtySteps.begin(), dirtySteps.end(), 0);
+    sequenceNotesAreValid = false;
+    syncedOctave = getZeroBasedOctave();
 }
 
 /**
  * Generate midiclip from channel patterns
  */
 void StepSequencerViewModel::generateMidiSequence() {
+    const juce::ScopedValueSetter<bool> syncing(isSyncingSequence, true);
+
     auto &sequence = midiClip->getSequence();
     sequence.clear(nullptr);
+    sequenceNotes.clear();
 
     for (int i = 0; i < getNumChannels(); i++) {
         for (int j = 0; j < getNumNotesPerChannel(); j++) {
@@ -652,33 +707,80 @@ void StepSequencerViewModel::generateMidiSequence() {
             }
         }
     }
+
+    std::fill(dirtySteps.begin(), dirtySteps.end(), 0);
+    sequenceNotesAreValid = true;
+    needsFullMidiRegeneration = false;
+    syncedOctave = getZeroBasedOctave();
+}
+
+void StepSequencerViewModel::syncMidiSequence() {
+    // the playback graph is rebuilt once for all the changes
+    const tracktion::TransportControl::ReallocationInhibitor inhibitor(
+        track->edit.getTransport());
+
+    if (!sequenceNotesAreValid)
+        rebuildSequenceNotes();
+
+    // notes are played with the current octave
+    if (needsFullMidiRegeneration || syncedOctave != getZeroBasedOctave()) {
+        generateMidiSequence();
+        return;
+    }
+
+    const juce::ScopedValueSetter<bool> syncing(isSyncingSequence, true);
+
+    for (size_t channel = 0; channel < dirtySteps.size(); channel++) {
+        auto steps = dirtySteps[channel];
+        while (steps != 0) {
+            syncStep(int(channel), std::countr_zero(steps));
+            // clear the lowest bit
+            steps &= steps - 1;
+        }
+
+        dirtySteps[channel] = 0;
+    }
+}
+
+void StepSequencerViewModel::markStepDirty(int channel, int noteIndex) {
+    if (juce::isPositiveAndBelow(channel, int(dirtySteps.size())) &&
+        juce::isPositiveAndBelow(noteIndex, 64))
+        dirtySteps[size_t(channel)] |= std::uint64_t(1) << noteIndex;
+}
+
+void StepSequencerViewModel::syncStep(int channel, int noteIndex) {
+    int intensity = noteIntensityAt(channel, noteIndex);
+    auto note = findNoteInSequence(channel, noteIndex);
+
+    if (intensity == 0) {
+        if (note.has_value())
+            removeNoteFromSequence(channel, noteIndex);
+    } else if (!note.has_value()) {
+        addNoteToSequence(channel, noteIndex, intensity);
+    } else if (note.value()->getVelocity() != intensityToVelocity(intensity)) {
+        note.value()->setVelocity(intensityToVelocity(intensity), nullptr);
+    }
 }
 
 void StepSequencerViewModel::addNoteToSequence(int channel, int noteIndex,
                                                int intensity) {
-    // intensity is an int between 0-7
-    // velocity is an int between 0 and 127
-    // ratio is 127 ÷ 7 ≃ 18
-    int velocity = intensity * 18;
-    // Need to get the pitch based on the sequence position and
-    // current octave remember that we need to add the min note
-    // number to get things correct since the min note number
-    // possible is not 0, its 5
-    int pitch =
-        channel + (NOTES_PER_OCTAVE * getZeroBasedOctave()) + MIN_NOTE_NUMBER;
-    auto startBeat = tracktion::BeatPosition::fromBeats(
-        double(noteIndex * 4.0) / double(notesPerMeasure.get()));
+    int velocity = intensityToVelocity(intensity);
+    int pitch = channelToPitch(channel);
+    auto startBeat = noteIndexToBeat(noteIndex);
     auto duration =
         tracktion::BeatDuration::fromBeats(4.0 / double(notesPerMeasure.get()));
 
     auto &sequence = midiClip->getSequence();
-    sequence.addNote(pitch, startBeat, duration, velocity, 1, nullptr);
+    if (auto note = sequence.addNote(pitch, startBeat, duration, velocity, 1,
+                                     nullptr))
+        sequenceNotes.emplace(noteKey(pitch, noteIndex), note);
 }
 
 void StepSequencerViewModel::removeNoteFromSequence(int channel,
                                                     int noteIndex) {
     auto note = findNoteInSequence(channel, noteIndex);
     if (note.has_value()) {
+        sequenceNotes.erase(noteKey(channelToPitch(channel), noteIndex));
         auto &sequence = midiClip->getSequence();
         sequence.removeNote(*note.value(), nullptr);
     }
@@ -686,25 +788,68 @@ void StepSequencerViewModel::removeNoteFromSequence(int channel,
 
 std::optional<tracktion::MidiNote *>
 StepSequencerViewModel::findNoteInSequence(int channel, int noteIndex) {
-    auto &sequence = midiClip->getSequence();
+    if (!sequenceNotesAreValid)
+        rebuildSequenceNotes();
 
-    // compute the note we want to remove
-    int pitch =
-        channel + (NOTES_PER_OCTAVE * getZeroBasedOctave()) + MIN_NOTE_NUMBER;
-    auto startBeat = tracktion::BeatPosition::fromBeats(
-        double(noteIndex * 4.0) / double(notesPerMeasure.get()));
-
-    // find the first node with matching pitch & startBeat
-    for (auto note : sequence.getNotes()) {
-        if (note->getStartBeat().inBeats() == startBeat.inBeats() &&
-            note->getNoteNumber() == pitch) {
-            return note;
-        }
-    }
+    auto it = sequenceNotes.find(noteKey(channelToPitch(channel), noteIndex));
+    if (it != sequenceNotes.end())
+        return it->second;
 
     return std::nullopt;
 }
 
+/**
+ * Index the notes of the midi clip by pitch & step.
+ * Notes the step sequencer would not generate (out of the grid, duplicated,
+ * out of the channels) require a full regeneration on the next sync.
+ */
+void StepSequencerViewModel::rebuildSequenceNotes() {
+    sequenceNotes.clear();
+
+    for (auto note : midiClip->getSequence().getNotes()) {
+        auto startBeat = note->getStartBeat().inBeats();
+        int noteIndex = int(std::lround(startBeat * notesPerMeasure.get() /
+                                        NB_BEATS_PER_MEASURE));
+        int channel = noteNumberToChannel(note->getNoteNumber());
+
+        bool isOnGrid =
+            juce::isPositiveAndBelow(channel, getNumChannels()) &&
+            juce::isPositiveAndBelow(noteIndex, getNumNotesPerChannel()) &&
+            noteIndexToBeat(noteIndex).inBeats() == startBeat;
+
+        auto key = noteKey(note->getNoteNumber(), noteIndex);
+        if (!isOnGrid || !sequenceNotes.emplace(key, note).second)
+            needsFullMidiRegeneration = true;
+    }
+
+    sequenceNotesAreValid = true;
+}
+
+int StepSequencerViewModel::noteKey(int pitch, int noteIndex) {
+    return pitch * MAX_MEASURES * MAX_NOTES_PER_MEASURE + noteIndex;
+}
+
+int StepSequencerViewModel::channelToPitch(int channel) {
+    // Need to get the pitch based on the sequence position and
+    // current octave remember that we need to add the min note
+    // number to get things correct since the min note number
+    // possible is not 0, its 5
+    return channel + (NOTES_PER_OCTAVE * getZeroBasedOctave()) +
+           MIN_NOTE_NUMBER;
+}
+
+tracktion::BeatPosition StepSequencerViewModel::noteIndexToBeat(int noteIndex) {
+    return tracktion::BeatPosition::fromBeats(double(noteIndex * 4.0) /
+                                              double(notesPerMeasure.get()));
+}
+
+int StepSequencerViewModel::intensityToVelocity(int intensity) {
+    // intensity is an int between 0-7
+    // velocity is an int between 0 and 127
+    // ratio is 127 ÷ 7 ≃ 18
+    return intensity * 18;
+}
+
 void StepSequencerViewModel::setVideoPosition(
     tracktion::TimePosition timePosition, bool /*forceJump*/) {
     // find beat of current time relative to the start of the midi clip
@@ -63,6 +63,20 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
     void copySelection();
     void pasteSelection();
 
+    /**
+     * Write the steps changed since the last sync to the midi clip.
+     * The whole clip is only regenerated when the octave changed or when it
+     * contains notes the step sequencer can't display.
+     */
+    void syncMidiSequence();
+
+    /**
+     * Group note changes: the midi clip is synced once, when the outermost
+     * `commitEdit()` is called.
+     */
+    void beginEdit();
+    void commitEdit();
+
     class Listener {
       public:
         virtual ~Listener() = default;
@@ -97,6 +111,7 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
 
     juce::ValueTree state;
     juce::ValueTree editState;
+    juce::ValueTree sequenceState;
     app_models::StepSequence stepSequence;
 
     tracktion::TimePosition midiClipStart;
@@ -122,16 +137,42 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
     juce::CachedValue<int> notesPerMeasure;
     juce::Array<int> notesPerMeasureOptions = juce::Array<int>({4, 8, 16});
 
+    // steps changed since the last midi sync, one bit per step and channel
+    std::vector<std::uint64_t> dirtySteps;
+    // midi clip notes indexed by `noteKey(pitch, noteIndex)`
+    std::unordered_map<int, tracktion::MidiNote *> sequenceNotes;
+    bool sequenceNotesAreValid = false;
+    bool needsFullMidiRegeneration = false;
+    bool isSyncingSequence = false;
+    int syncedOctave = 0;
+    int editDepth = 0;
+
     void handleAsyncUpdate() override;
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
                                   const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parentTree,
+                             juce::ValueTree &childWhichHasBeenAdded) override;
+    void valueTreeChildRemoved(juce::ValueTree &parentTree,
+                               juce::ValueTree &childWhichHasBeenRemoved,
+                               int indexFromWhichChildWasRemoved) override;
 
     void generateStepSequenceFromMidi();
     void generateMidiSequence();
+    void markStepDirty(int channel, int noteIndex);
+    /**
+     * Sync the midi clip unless an edit is in progress
+     */
+    void requestMidiSync();
+    void syncStep(int channel, int noteIndex);
     void addNoteToSequence(int channel, int noteIndex, int dumbVelocity);
     void removeNoteFromSequence(int channel, int noteIndex);
     std::optional<tracktion::MidiNote *> findNoteInSequence(int channel,
                                                             int noteIndex);
+    void rebuildSequenceNotes();
+    int noteKey(int pitch, int noteIndex);
+    int channelToPitch(int channel);
+    tracktion::BeatPosition noteIndexToBeat(int noteIndex);
+    static int intensityToVelocity(int intensity);
 
     tracktion::MidiClip *editCurrentMidiClip();
     tracktion::MidiClip *insertMidiClip();
@@ -45,8 +45,9 @@ void AudioBufferSizeListViewModel::updateAudioBufferSize() {
     setup.bufferSize = getSelectedItem().getIntValue();
     auto result = deviceManager.setAudioDeviceSetup(setup, true);
     if (result != "") {
-        juce::Logger::writeToLog("Error setting buffer size to " +
-                                 getSelectedItem() + ": " + result);
+        app_services::AsyncFileLogger::write(
+            app_services::AsyncFileLogger::Level::error,
+            "Error setting buffer size to " + getSelectedItem() + ": " + result);
     }
 }
 
@@ -29,6 +29,13 @@ juce::String LoadSaveSongListViewModel::getSelectedItem() {
     return songNames[itemListState.getSelectedItemIndex()];
 }
 
+juce::File LoadSaveSongListViewModel::getProjectFile(int index) const {
+    if (!juce::isPositiveAndNotGreaterThan(index, int(projects.size())))
+        return {};
+
+    return projects[size_t(index - 1)].file;
+}
+
 void LoadSaveSongListViewModel::selectedIndexChanged(int /*newIndex*/) {
     // Here you can add the logic you need when you change the index selected
 }
@@ -37,11 +44,11 @@ void LoadSaveSongListViewModel::loadSongList(const juce::File &directory) {
     songNames.clear();
     songNames.add("Add");
 
-    juce::Array<juce::File> songFiles =
-        directory.findChildFiles(juce::File::findFiles, false, "*.xml");
+    // the index only scans the directory if it changed since the last time
+    projects = app_services::ProjectIndex::getEntries(directory);
 
-    for (const auto &file : songFiles) {
-        songNames.add(file.getFileNameWithoutExtension());
+    for (const auto &project : projects) {
+        songNames.add(getItemName(project));
     }
 
     itemListState.listSize = songNames.size();
@@ -49,29 +56,32 @@ void LoadSaveSongListViewModel::loadSongList(const juce::File &directory) {
         0); // Optional: Reset to the first item or any other
     itemListState.addListener(this);
 }
+juce::String LoadSaveSongListViewModel::getItemName(
+    const app_services::ProjectIndex::Entry &project) {
+    // projects which couldn't be read have no tracks
+    if (project.numTracks <= 0)
+        return project.getName();
+
+    return project.getName() + " (" + juce::String(project.numTracks) +
+           (project.numTracks == 1 ? " track, " : " tracks, ") +
+           juce::String(juce::roundToInt(project.tempo)) + " BPM)";
+}
+
 void saveEditState(const tracktion::engine::Edit &edit,
                    const juce::File &file) {
-    // Serialize Edit status to XML
-    auto xml = edit.state.createXml();
-
-    // Save the XML to a file
-    if (xml) {
-        if (!xml->writeTo(file)) {
-            // Handle error if write fails
-            DBG("Failed to write Edit state to file.");
-        }
-    } else {
-        // Handling error if serialization fails
-        DBG("Failed to create XML from Edit state.");
+    // Serialize Edit status in the format matching the file extension
+    if (!app_services::EditSaveService::writeAtomically(edit.state, file)) {
+        // Handle error if write fails
+        DBG("Failed to write Edit state to file.");
     }
 }
 void loadEditState(tracktion::engine::Edit &edit, const juce::File &file) {
-    // Read the XML from the file
-    auto xml = juce::XmlDocument::parse(file);
+    // Read the XML or binary project from the file
+    auto state = app_services::ProjectFile::read(file);
 
-    if (xml) {
-        // Deserialize XML to restore Edit status
-        edit.state = juce::ValueTree::fromXml(*xml);
+    if (state.isValid()) {
+        // Restore Edit status
+        edit.state = state;
     } else {
         // Handle error if file reading fails
         DBG("Failed to read Edit state from file.");
@@ -13,6 +13,10 @@ class LoadSaveSongListViewModel : private ItemListState::Listener {
 
     juce::StringArray getItemNames();
     juce::String getSelectedItem();
+    /**
+     * Project file of a song in the list, the first item ("Add") has none
+     */
+    juce::File getProjectFile(int index) const;
     // void updateDeviceManagerDeviceType();
     // void loadSongList();
 
@@ -20,9 +24,17 @@ class LoadSaveSongListViewModel : private ItemListState::Listener {
     juce::AudioDeviceManager &deviceManager;
     juce::ValueTree state;
     juce::String applicationName;
+    // projects in the same order as songNames, without the "Add" item
+    std::vector<app_services::ProjectIndex::Entry> projects;
 
     void selectedIndexChanged(int newIndex) override;
     void loadSongList(const juce::File &directory);
+    /**
+     * Name of the project followed by its track count and tempo, read from
+     * the project index
+     */
+    static juce::String
+    getItemName(const app_services::ProjectIndex::Entry &project);
 
   public:
     // Must appear below the other variables since it needs to be initialized
@@ -42,8 +42,10 @@ void OutputListViewModel::updateOutput() {
     setup.outputDeviceName = getSelectedItem();
     auto result = deviceManager.setAudioDeviceSetup(setup, true);
     if (result != "") {
-        juce::Logger::writeToLog("Error setting output device to " +
-                                 getSelectedItem() + ": " + result);
+        app_services::AsyncFileLogger::write(
+            app_services::AsyncFileLogger::Level::error,
+            "Error setting output device to " + getSelectedItem() + ": " +
+                result);
     }
 }
 
@@ -44,8 +44,9 @@ void SampleRateListViewModel::updateSampleRate() {
     setup.sampleRate = getSelectedItem().getDoubleValue();
     auto result = deviceManager.setAudioDeviceSetup(setup, true);
     if (result != "") {
-        juce::Logger::writeToLog("Error setting sample rate to " +
-                                 getSelectedItem() + ": " + result);
+        app_services::AsyncFileLogger::write(
+            app_services::AsyncFileLogger::Level::error,
+            "Error setting sample rate to " + getSelectedItem() + ": " + result);
     }
 }
 
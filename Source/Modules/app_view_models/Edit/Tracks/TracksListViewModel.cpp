@@ -227,8 +227,8 @@ void TracksListViewModel::stopRecordingOrPlaying() {
     if (transport.isPlaying() || transport.isRecording()) {
         transport.stop(false, false);
 
-        tracktion::EditFileOperations fileOperations(edit);
-        fileOperations.save(true, true, false);
+        // written in the background so stopping stays responsive
+        saveService->requestSave(edit);
 
     } else {
         // if we try to stop while currently not playing
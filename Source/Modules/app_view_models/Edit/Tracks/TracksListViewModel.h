@@ -79,6 +79,7 @@ class TracksListViewModel : public juce::ValueTree::Listener,
   private:
     tracktion::Edit &edit;
     app_services::TimelineCamera &camera;
+    juce::SharedResourcePointer<app_services::EditSaveService> saveService;
     std::unique_ptr<TracksListAdapter> adapter;
     juce::ValueTree state;
 
@@ -70,7 +70,9 @@ namespace app_view_models {
 #include <app_models/app_models.h>
 #include <app_services/app_services.h>
 #include <internal_plugins/internal_plugins.h>
+#include <bit>
 #include <functional>
+#include <unordered_map>
 #include <app_configuration/app_configuration.h>
 
 // Utilities
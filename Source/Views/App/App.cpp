@@ -42,4 +42,9 @@ void App::resized() {
 }
 
 void App::showProgressView() { progressView.setVisible(true); }
-void App::hideProgressView() { progressView.setVisible(false); }
+void App::hideProgressView() {
+    progressView.setVisible(false);
+    progressView.setProgress(-1.0f);
+}
+
+void App::setProgress(float progress) { progressView.setProgress(progress); }
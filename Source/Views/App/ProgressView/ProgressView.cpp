@@ -2,7 +2,33 @@
 
 ProgressView::ProgressView() {
     addAndMakeVisible(svgImageComponent);
-    startTimerHz(refreshRate);
+    frameScheduler->addClient(this, this,
+                              app_services::FrameScheduler::frameRate /
+                                  refreshRate);
+}
+
+ProgressView::~ProgressView() { frameScheduler->removeClient(this); }
+
+void ProgressView::paint(juce::Graphics &g) {
+    if (progress < 0.0f)
+        return;
+
+    auto bounds = getLocalBounds().toFloat().reduced(2.0f);
+    auto radius = juce::jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
+    juce::Path arc;
+    arc.addCentredArc(bounds.getCentreX(), bounds.getCentreY(), radius, radius,
+                      0.0f, 0.0f,
+                      juce::MathConstants<float>::twoPi * progress, true);
+    g.setColour(appLookAndFeel.colour1);
+    g.strokePath(arc, juce::PathStrokeType(3.0f));
+}
+
+void ProgressView::setProgress(float newProgress) {
+    if (juce::approximatelyEqual(progress, newProgress))
+        return;
+
+    progress = newProgress;
+    repaint();
 }
 
 void ProgressView::resized() {
@@ -16,7 +42,7 @@ void ProgressView::resized() {
                          getLocalBounds().reduced(4));
 }
 
-void ProgressView::timerCallback() { resized(); }
+void ProgressView::frameCallback() { resized(); }
 
 void ProgressView::setRotatedWithBounds(Component &component, float angle,
                                         bool clockWiseRotation,
@@ -2,17 +2,29 @@
 #include "AppLookAndFeel.h"
 #include "SVGImageComponent.h"
 #include "juce_gui_basics/juce_gui_basics.h"
+#include <app_services/app_services.h>
 
-class ProgressView : public juce::Component, private juce::Timer {
+class ProgressView : public juce::Component,
+                     private app_services::FrameScheduler::Client {
   public:
     ProgressView();
+    ~ProgressView() override;
+    void paint(juce::Graphics &g) override;
     void resized() override;
 
+    /**
+     * Draw the progress around the spinner, between 0 & 1.
+     * A negative value only shows the spinner.
+     */
+    void setProgress(float newProgress);
+
   private:
     AppLookAndFeel appLookAndFeel;
     SVGImageComponent svgImageComponent;
     int refreshRate = 30;
-    void timerCallback() override;
+    float progress = -1.0f;
+    juce::SharedResourcePointer<app_services::FrameScheduler> frameScheduler;
+    void frameCallback() override;
 
     static void setRotatedWithBounds(Component &component, float angle,
                                      bool clockWiseRotation,
@@ -1,5 +1,6 @@
 #include "EditTabBarView.h"
 #include "AvailableSequencersListView.h"
+#include "ExtendedUIBehaviour.h"
 #include "FourOscView.h"
 #include "MixerView.h"
 #include "PluginView.h"
@@ -11,7 +12,7 @@
 EditTabBarView::EditTabBarView(tracktion::Edit &e,
                                app_services::MidiCommandManager &mcm)
     : TabbedComponent(juce::TabbedButtonBar::Orientation::TabsAtTop), edit(e),
-      midiCommandManager(mcm), viewModel(edit) {
+      midiCommandManager(mcm), viewModel(edit), renderService(edit) {
     // Note: Some tabs are on a per-track basis and are added in
     // selectedIndexChanged, not here this is possible since this view is a
     // listener of the tracks item list state
@@ -47,6 +48,8 @@ EditTabBarView::EditTabBarView(tracktion::Edit &e,
 
     midiCommandManager.addListener(this);
     viewModel.addListener(this);
+    renderService.addListener(this);
+    saveService->addListener(this);
 
     // Set tracks as initial view
     setCurrentTabIndex(tracksIndex);
@@ -55,6 +58,8 @@ EditTabBarView::EditTabBarView(tracktion::Edit &e,
 EditTabBarView::~EditTabBarView() {
     midiCommandManager.removeListener(this);
     viewModel.removeListener(this);
+    renderService.removeListener(this);
+    saveService->removeListener(this);
     juce::StringArray tabNames = getTabNames();
     int tracksIndex = tabNames.indexOf(tracksTabName);
 
@@ -134,8 +139,6 @@ void EditTabBarView::tempoSettingsButtonReleased() {
 void EditTabBarView::saveButtonReleased() {
     const auto track_name = ConfigurationHelpers::getSavedTrackName();
 
-    // editFile.create();
-    tracktion::EditFileOperations fileOperations(edit);
     auto userAppDataDirectory = juce::File::getSpecialLocation(
         juce::File::userApplicationDataDirectory);
 
@@ -151,31 +154,45 @@ void EditTabBarView::saveButtonReleased() {
         }
     }
 
-    if (track_name.exists()) {
-        fileOperations.saveAs(track_name, true);
-    }
     auto saveFile = savedDirectory.getChildFile(track_name.getFileName());
 
-    if (track_name.copyFileTo(saveFile)) {
-        juce::Logger::writeToLog("Track copied to: " +
-                                 saveFile.getFullPathName());
-    } else {
-        juce::Logger::writeToLog("Error copying to: " +
-                                 saveFile.getFullPathName());
+    // the same snapshot is written to the track file and to the saved copy,
+    // the message is shown once the copy has been written (see editSaved)
+    juce::Array<juce::File> destinations;
+    if (track_name.exists())
+        destinations.add(track_name);
+
+    destinations.add(saveFile);
+    savedCopyFile = saveFile;
+    saveService->requestSave(edit, destinations);
+}
+
+void EditTabBarView::editSaved(const juce::File &destination, bool success) {
+    if (destination != savedCopyFile)
+        return;
+
+    savedCopyFile = juce::File();
+
+    if (!success) {
+        showMessage("Save Failed!");
+        return;
     }
 
+    juce::Logger::writeToLog("Track saved to: " +
+                             destination.getFullPathName());
     juce::Logger::writeToLog("Complete! (" +
-                             track_name.getFileNameWithoutExtension() + ")");
-    messageBox.setMessage("Complete! (" +
-                          track_name.getFileNameWithoutExtension() + ")");
-    resized();
-    messageBox.setVisible(true);
-    startTimer(1000);
+                             destination.getFileNameWithoutExtension() + ")");
+    showMessage("Complete! (" + destination.getFileNameWithoutExtension() +
+                ")");
 }
 
 void EditTabBarView::renderButtonReleased() {
     if (isShowing()) {
-        juce::Logger::writeToLog("Rendering edit ...");
+        if (renderService.isRendering()) {
+            showMessage("Render in progress");
+            return;
+        }
+
         auto userAppDataDirectory = juce::File::getSpecialLocation(
             juce::File::userApplicationDataDirectory);
 
@@ -185,23 +202,65 @@ void EditTabBarView::renderButtonReleased() {
                               .getChildFile("renders")
                               .getNonexistentChildFile(renderFileName, ".wav");
 
-        auto timeRange = tracktion::TimeRange(
-            tracktion::TimePosition::fromSeconds(0.0), edit.getLength());
-        juce::BigInteger tracksToDo{0};
-        for (auto i = 0; i < tracktion::getAllTracks(edit).size(); i++)
-            tracksToDo.setBit(i);
+        // the render runs in the background, see renderFinished
+        renderService.startRender(renderFile);
+    }
+}
+
+void EditTabBarView::controllerEventReceived(int controllerNumber, int value) {
+    // the stop button is only sent to the focused component, so it's caught
+    // here to cancel the render whatever view is shown
+    if (isShowing() && renderService.isRendering() && value == 0 &&
+        midiCommandManager.getCommand(controllerNumber) ==
+            app_services::MidiCommandManager::Command::stop)
+        renderService.cancelRender();
+}
 
-        tracktion::Renderer::renderToFile("Render", renderFile, edit, timeRange,
-                                          tracksToDo, true, true, {}, true);
+void EditTabBarView::renderStarted(const juce::File &destination) {
+    juce::Logger::writeToLog("Rendering edit to " +
+                             destination.getFullPathName() + " ...");
+
+    if (auto uiBehaviour =
+            dynamic_cast<ExtendedUIBehaviour *>(&edit.engine.getUIBehaviour()))
+        uiBehaviour->showProgress(0.0f);
+}
+
+void EditTabBarView::renderProgressChanged(float progress) {
+    if (auto uiBehaviour =
+            dynamic_cast<ExtendedUIBehaviour *>(&edit.engine.getUIBehaviour()))
+        uiBehaviour->showProgress(progress);
+}
+
+void EditTabBarView::renderFinished(
+    const juce::File & /*destination*/,
+    app_services::EditRenderService::Result result) {
+    if (auto uiBehaviour =
+            dynamic_cast<ExtendedUIBehaviour *>(&edit.engine.getUIBehaviour()))
+        uiBehaviour->hideProgress();
+
+    switch (result) {
+    case app_services::EditRenderService::Result::completed:
         juce::Logger::writeToLog("Render complete!");
-        messageBox.setMessage("Render Complete!");
-        // must call resized so message box width is updated to fit text
-        resized();
-        messageBox.setVisible(true);
-        startTimer(1000);
+        showMessage("Render Complete!");
+        break;
+    case app_services::EditRenderService::Result::cancelled:
+        juce::Logger::writeToLog("Render cancelled");
+        showMessage("Render Cancelled");
+        break;
+    case app_services::EditRenderService::Result::failed:
+        showMessage("Render Failed!");
+        break;
     }
 }
 
+void EditTabBarView::showMessage(const juce::String &message) {
+    messageBox.setMessage(message);
+    // must call resized so message box width is updated to fit text
+    resized();
+    messageBox.setVisible(true);
+    startTimer(1000);
+}
+
 void EditTabBarView::mixerButtonReleased() {
     if (isShowing()) {
         juce::StringArray tabNames = getTabNames();
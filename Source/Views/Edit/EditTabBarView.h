@@ -11,6 +11,8 @@ class EditTabBarView : public juce::TabbedComponent,
                        public app_services::MidiCommandManager::Listener,
                        public app_view_models::ItemListState::Listener,
                        public app_view_models::EditViewModel::Listener,
+                       public app_services::EditRenderService::Listener,
+                       public app_services::EditSaveService::Listener,
                        juce::Timer {
   public:
     EditTabBarView(tracktion::Edit &e, app_services::MidiCommandManager &mcm);
@@ -31,6 +33,7 @@ class EditTabBarView : public juce::TabbedComponent,
 
     // MidiCommandManager Listener
     void octaveChanged(int newOctave) override;
+    void controllerEventReceived(int controllerNumber, int value) override;
 
     // Used to reset the modifiers list when ever a plugin gets deleted
     void resetModifiersTab();
@@ -41,10 +44,24 @@ class EditTabBarView : public juce::TabbedComponent,
     // ViewModel listener
     void trackDeleted() override;
 
+    // EditRenderService listener
+    void renderStarted(const juce::File &destination) override;
+    void renderProgressChanged(float progress) override;
+    void renderFinished(
+        const juce::File &destination,
+        app_services::EditRenderService::Result result) override;
+
+    // EditSaveService listener
+    void editSaved(const juce::File &destination, bool success) override;
+
   private:
     tracktion::Edit &edit;
     app_services::MidiCommandManager &midiCommandManager;
     app_view_models::EditViewModel viewModel;
+    app_services::EditRenderService renderService;
+    juce::SharedResourcePointer<app_services::EditSaveService> saveService;
+    // copy in the saved directory written by the save button
+    juce::File savedCopyFile;
     juce::String tracksTabName = "TRACKS";
     juce::String tempoSettingsTabName = "TEMPO_SETTINGS";
     juce::String mixerTabName = "MIXER";
@@ -58,6 +75,7 @@ class EditTabBarView : public juce::TabbedComponent,
     MessageBox messageBox;
 
     void timerCallback() override;
+    void showMessage(const juce::String &message);
     void resetTrackRelatedTabs();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditTabBarView)
@@ -6,12 +6,12 @@ LevelMeterComponent::LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan)
     currentLeveldB = levelClient.getAndClearAudioLevel(channel).dB;
     setOpaque(true);
     levelMeasurer.addClient(levelClient);
-    startTimerHz(120);
+    frameScheduler->addClient(this, this);
 }
 
 LevelMeterComponent::~LevelMeterComponent() {
     levelMeasurer.removeClient(levelClient);
-    stopTimer();
+    frameScheduler->removeClient(this);
 }
 void LevelMeterComponent::paint(juce::Graphics &g) {
     g.fillAll(
@@ -40,7 +40,7 @@ void LevelMeterComponent::paint(juce::Graphics &g) {
                float(meterWidth), 1.0f);
 }
 
-void LevelMeterComponent::timerCallback() {
+void LevelMeterComponent::frameCallback() {
     prevLeveldB = currentLeveldB;
 
     currentLeveldB = levelClient.getAndClearAudioLevel(channel).dB;
@@ -52,7 +52,8 @@ void LevelMeterComponent::timerCallback() {
     const auto prevLevel{juce::Decibels::decibelsToGain(prevLeveldB)};
 
     if (prevLeveldB > currentLeveldB) {
-        currentLeveldB = juce::Decibels::gainToDecibels(prevLevel * 0.94);
+        currentLeveldB =
+            juce::Decibels::gainToDecibels(prevLevel * decayPerFrame);
     }
 
     // the test below may save some unnecessary paints
@@ -1,17 +1,17 @@
 #pragma once
 #include "AppLookAndFeel.h"
+#include <app_services/app_services.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
 
-class LevelMeterComponent : public juce::Component, public juce::Timer {
+class LevelMeterComponent : public juce::Component,
+                            private app_services::FrameScheduler::Client {
   public:
     explicit LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan);
     ~LevelMeterComponent() override;
 
     void paint(juce::Graphics &g) override;
 
-    void timerCallback() override;
-
   private:
     int channel = 0;
 
@@ -25,7 +25,14 @@ class LevelMeterComponent : public juce::Component, public juce::Timer {
     tracktion::LevelMeasurer &levelMeasurer;
     tracktion::LevelMeasurer::Client levelClient;
 
+    // gain kept from one frame to the next while the level falls, 0.94 at
+    // 120Hz
+    static constexpr double decayPerFrame = 0.94 * 0.94;
+    juce::SharedResourcePointer<app_services::FrameScheduler> frameScheduler;
+
     AppLookAndFeel appLookAndFeel;
 
+    void frameCallback() override;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeterComponent)
 };
@@ -133,7 +133,9 @@ class ExtendedUIBehaviour : public tracktion::UIBehaviour {
             return internalPluginView;
         }
 
-        juce::Logger::writeToLog("failed to create editor");
+        app_services::AsyncFileLogger::write(
+            app_services::AsyncFileLogger::Level::error,
+            "failed to create editor");
         return {};
     }
 
@@ -145,6 +147,22 @@ class ExtendedUIBehaviour : public tracktion::UIBehaviour {
 
     void setApp(App *a) { app = a; }
 
+    /**
+     * Show the progress view with the progress of a background task,
+     * between 0 & 1
+     */
+    void showProgress(float progress) {
+        if (app != nullptr) {
+            app->showProgressView();
+            app->setProgress(progress);
+        }
+    }
+
+    void hideProgress() {
+        if (app != nullptr)
+            app->hideProgressView();
+    }
+
     tracktion::Edit *getCurrentlyFocusedEdit() override { return edit; }
 
     void
@@ -155,22 +173,21 @@ class ExtendedUIBehaviour : public tracktion::UIBehaviour {
         }
 
         while (runner.isThreadRunning()) {
-            if (!juce::MessageManager::getInstance()->runDispatchLoopUntil(
-                    10)) {
-                // Can update the GUI here if we need to, but since its just a
-                // continuous loading animation we dont need to do anything for
-                // now
-            }
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+
+            if (app != nullptr)
+                app->setProgress(t.getCurrentTaskProgress());
         }
 
         // Once the thread finishes, hide the progress view
-        app->hideProgressView();
+        if (app != nullptr)
+            app->hideProgressView();
     }
 
   private:
-    tracktion::Edit *edit;
-    app_services::MidiCommandManager *midiCommandManager;
-    App *app;
+    tracktion::Edit *edit = nullptr;
+    app_services::MidiCommandManager *midiCommandManager = nullptr;
+    App *app = nullptr;
 
     struct TaskRunner : public juce::Thread {
         explicit TaskRunner(tracktion::ThreadPoolJobWithProgress &t)
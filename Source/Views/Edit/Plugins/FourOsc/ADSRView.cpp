@@ -112,52 +112,30 @@ void ADSRView::gridSetup() {
     grid.performLayout(bounds);
 }
 
-void ADSRView::encoder1Increased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.incrementAttack();
-}
-
-void ADSRView::encoder1Decreased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.decrementAttack();
-}
-
-void ADSRView::encoder2Increased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.incrementDecay();
-}
-
-void ADSRView::encoder2Decreased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.decrementDecay();
-}
-
-void ADSRView::encoder3Increased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.incrementSustain();
-}
-
-void ADSRView::encoder3Decreased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.decrementSustain();
-}
-
-void ADSRView::encoder4Increased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.incrementRelease();
-}
-
-void ADSRView::encoder4Decreased() {
-    if (isShowing())
-        if (midiCommandManager.getFocusedComponent() == this)
-            viewModel.decrementRelease();
+void ADSRView::encoderMoved(int encoder, int delta, double velocity) {
+    if (!isShowing() || midiCommandManager.getFocusedComponent() != this)
+        return;
+
+    // a whole sweep is applied with one parameter write
+    auto steps =
+        midiCommandManager.getAcceleratedDelta(encoder, delta, velocity);
+
+    switch (encoder) {
+    case 1:
+        viewModel.changeAttack(steps);
+        break;
+    case 2:
+        viewModel.changeDecay(steps);
+        break;
+    case 3:
+        viewModel.changeSustain(steps);
+        break;
+    case 4:
+        viewModel.changeRelease(steps);
+        break;
+    default:
+        break;
+    }
 }
 
 void ADSRView::parametersChanged() {
@@ -18,17 +18,7 @@ class ADSRView : public juce::Component,
     void paint(juce::Graphics &g) override;
     void resized() override;
 
-    void encoder1Increased() override;
-    void encoder1Decreased() override;
-
-    void encoder2Increased() override;
-    void encoder2Decreased() override;
-
-    void encoder3Increased() override;
-    void encoder3Decreased() override;
-
-    void encoder4Increased() override;
-    void encoder4Decreased() override;
+    void encoderMoved(int encoder, int delta, double velocity) override;
 
     void parametersChanged() override;
 
@@ -287,6 +287,13 @@ void SamplerView::gainChanged() {
     resized();
 }
 
+void SamplerView::itemsChanged() {
+    titledList.setListItems(viewModel->getItemNames());
+    titledList.getListView().getListBox().selectRow(
+        viewModel->itemListState.getSelectedItemIndex());
+    resized();
+}
+
 void SamplerView::noteOnPressed(int noteNumber) {
     if (isShowing())
         if (midiCommandManager.getFocusedComponent() == this)
@@ -33,6 +33,7 @@ class SamplerView : public juce::Component,
     void fullSampleThumbnailChanged() override;
     void sampleExcerptThumbnailChanged() override;
     void gainChanged() override;
+    void itemsChanged() override;
 
     void encoder1Increased() override;
     void encoder1Decreased() override;
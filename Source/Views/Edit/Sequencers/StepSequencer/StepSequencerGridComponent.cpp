@@ -11,31 +11,85 @@ StepSequencerGridComponent::~StepSequencerGridComponent() {
 }
 
 void StepSequencerGridComponent::paint(juce::Graphics &g) {
-    g.setColour(appLookAndFeel.colour1.withAlpha(.3f));
+    if (!gridImageIsValid)
+        renderGrid();
+
+    g.drawImageAt(gridImage, 0, 0);
+
+    // draw index marker
+    g.setColour(appLookAndFeel.colour3);
+    g.drawRect(float(startX - (lineThickness / 2) +
+                     float(viewModel.getSelectedNoteIndex()) * colSpacing),
+               float(startY) - (lineThickness / 2),
+               float(colSpacing) + (lineThickness),
+               float(endY - startY) + (lineThickness), lineThickness);
+
+    // draw range selection
+    if (viewModel.isRangeSelectionActive()) {
+        g.setColour(appLookAndFeel.colour3.withAlpha(0.5f));
+        g.fillRect(float(startX - (lineThickness / 2) +
+                         float(viewModel.getRangeStartIndex()) * colSpacing),
+                   float(startY) - (lineThickness / 2),
+
+                   float(viewModel.getRangeEndIndex() -
+                         viewModel.getRangeStartIndex() + 1) *
+                       colSpacing,
+                   float(endY - startY + lineThickness));
+    }
+}
 
+void StepSequencerGridComponent::resized() {
+    updateLayout();
+    invalidateGrid();
+}
+
+void StepSequencerGridComponent::updateLayout() {
     float paddingTop = 4;
     float paddingBottom = 4;
     float paddingLeft = 4;
     float paddingRight = 4;
 
     // have to make sure it divides evenly, increase padding a bit until it does
-    int numRows = 24;
-    while (int(float(getHeight()) - (paddingBottom + paddingTop)) % numRows !=
-           0)
-        paddingTop += 1;
-    float rowSpacing =
+    int gridHeight = juce::jmax(0, getHeight() - 8);
+    paddingTop += float(gridHeight % numRows);
+    rowSpacing =
         (float(getHeight()) - (paddingBottom + paddingTop)) / float(numRows);
 
     int numCols = viewModel.getNotesPerMeasure() * 4;
-    while (int((float(getWidth()) - (paddingLeft + paddingRight))) % 2 != 0)
-        paddingLeft += 1;
-    float colSpacing =
+    int gridWidth = juce::jmax(0, getWidth() - 8);
+    paddingLeft += float(gridWidth % 2);
+    colSpacing =
         (float(getWidth()) - (paddingLeft + paddingRight)) / float(numCols);
 
-    float startY = paddingTop;
-    float endY = startY + float(numRows) * rowSpacing;
+    startY = paddingTop;
+    endY = startY + float(numRows) * rowSpacing;
+    startX = paddingLeft;
+
+    overlayBounds = getOverlayBounds();
+}
+
+void StepSequencerGridComponent::invalidateGrid() {
+    gridImageIsValid = false;
+    repaint();
+}
+
+void StepSequencerGridComponent::renderGrid() {
+    gridImageIsValid = true;
+
+    if (getWidth() <= 0 || getHeight() <= 0) {
+        gridImage = juce::Image();
+        return;
+    }
+
+    if (gridImage.getWidth() != getWidth() ||
+        gridImage.getHeight() != getHeight())
+        gridImage = juce::Image(juce::Image::ARGB, getWidth(), getHeight(),
+                                true);
+    else
+        gridImage.clear(gridImage.getBounds());
+
+    juce::Graphics g(gridImage);
 
-    float startX = paddingLeft;
     float endX = startX + float(viewModel.getNumberOfNotes()) * colSpacing;
 
     // draw rectangles for notes
@@ -69,8 +123,8 @@ void StepSequencerGridComponent::paint(juce::Graphics &g) {
 
     // draw lines for rows and cols
     float rowY = startY;
+    g.setColour(appLookAndFeel.colour1.withAlpha(.3f));
     for (int i = 0; i < numRows + 1; i++) {
-        g.setColour(appLookAndFeel.colour1.withAlpha(.3f));
         g.drawLine(startX, rowY, endX, rowY, 1);
         rowY += rowSpacing;
     }
@@ -85,56 +139,58 @@ void StepSequencerGridComponent::paint(juce::Graphics &g) {
         g.drawLine(colX, startY, colX, endY, 1);
         colX += colSpacing;
     }
+}
 
-    // draw index marker
-    g.setColour(appLookAndFeel.colour3);
-    float lineThickness = 3.0f;
-    g.drawRect(float(startX - (lineThickness / 2) +
-                     float(viewModel.getSelectedNoteIndex()) * colSpacing),
-               float(startY) - (lineThickness / 2),
-               float(colSpacing) + (lineThickness),
-               float(endY - startY) + (lineThickness), lineThickness);
+juce::Rectangle<int> StepSequencerGridComponent::getOverlayBounds() {
+    float top = startY - lineThickness;
+    float height = endY - startY + 2 * lineThickness;
 
-    // draw range selection
-    if (viewModel.isRangeSelectionActive()) {
-        g.setColour(appLookAndFeel.colour3.withAlpha(0.5f));
-        g.fillRect(float(startX - (lineThickness / 2) +
-                         float(viewModel.getRangeStartIndex()) * colSpacing),
-                   float(startY) - (lineThickness / 2),
+    auto markerBounds = juce::Rectangle<float>(
+        startX - lineThickness +
+            float(viewModel.getSelectedNoteIndex()) * colSpacing,
+        top, colSpacing + 2 * lineThickness, height);
 
-                   float(viewModel.getRangeEndIndex() -
-                         viewModel.getRangeStartIndex() + 1) *
-                       colSpacing,
-                   float(endY - startY + lineThickness));
+    if (viewModel.isRangeSelectionActive()) {
+        auto rangeBounds = juce::Rectangle<float>(
+            startX - lineThickness +
+                float(viewModel.getRangeStartIndex()) * colSpacing,
+            top,
+            float(viewModel.getRangeEndIndex() -
+                  viewModel.getRangeStartIndex() + 1) *
+                    colSpacing +
+                2 * lineThickness,
+            height);
+        markerBounds = markerBounds.getUnion(rangeBounds);
     }
-}
 
-void StepSequencerGridComponent::resized() {}
+    return markerBounds.getSmallestIntegerContainer();
+}
 
-void StepSequencerGridComponent::patternChanged() {
-    resized();
-    repaint();
+void StepSequencerGridComponent::repaintOverlay() {
+    // only the columns covered by the old & new markers need to be redrawn
+    repaint(overlayBounds);
+    overlayBounds = getOverlayBounds();
+    repaint(overlayBounds);
 }
 
+void StepSequencerGridComponent::patternChanged() { invalidateGrid(); }
+
 void StepSequencerGridComponent::selectedNoteIndexChanged(int /*newIndex*/) {
-    resized();
-    repaint();
+    repaintOverlay();
 }
 
 void StepSequencerGridComponent::numberOfNotesChanged(
     int /*newNumberOfNotes*/) {
-    resized();
-    repaint();
+    invalidateGrid();
 }
 
 void StepSequencerGridComponent::notesPerMeasureChanged(
     int /*newNotesPerMeasure*/) {
-    resized();
-    repaint();
+    updateLayout();
+    invalidateGrid();
 }
 
 void StepSequencerGridComponent::rangeSelectionEnabledChanged(
     bool /*rangeSelectionEnabled*/) {
-    resized();
-    repaint();
+    repaintOverlay();
 }
@@ -25,5 +25,28 @@ class StepSequencerGridComponent
     app_view_models::StepSequencerViewModel &viewModel;
     AppLookAndFeel appLookAndFeel;
 
+    const int numRows = 24;
+    const float lineThickness = 3.0f;
+
+    // grid geometry, updated when resized or notes per measure change
+    float startX = 0;
+    float startY = 0;
+    float endY = 0;
+    float rowSpacing = 0;
+    float colSpacing = 0;
+
+    // grid lines and notes, only redrawn when the pattern changes
+    juce::Image gridImage;
+    bool gridImageIsValid = false;
+
+    // area covered by the index marker & range selection when last painted
+    juce::Rectangle<int> overlayBounds;
+
+    void updateLayout();
+    void invalidateGrid();
+    void renderGrid();
+    juce::Rectangle<int> getOverlayBounds();
+    void repaintOverlay();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StepSequencerGridComponent)
 };
@@ -16,6 +16,9 @@ LoadSaveSongListView::LoadSaveSongListView(
     midiCommandManager.addListener(this);
 
     addAndMakeVisible(titledList);
+
+    addChildComponent(messageBox);
+    messageBox.setAlwaysOnTop(true);
 }
 
 LoadSaveSongListView::~LoadSaveSongListView() {
@@ -84,8 +87,17 @@ void LoadSaveSongListView::encoder1ButtonReleased() {
             auto seconds =
                 juce::String(currentTime.getSeconds()).paddedLeft('0', 2);
 
-            juce::String newEditFileName = "edit_" + day + month + year +
-                                           hours + minutes + seconds + ".xml";
+            auto configFile =
+                userAppDataDirectory.getChildFile(JUCE_APPLICATION_NAME_STRING)
+                    .getChildFile("config.yaml");
+            auto format =
+                ConfigurationHelpers::getUseBinaryProjectFormat(configFile)
+                    ? app_services::ProjectFile::Format::binary
+                    : app_services::ProjectFile::Format::xml;
+
+            juce::String newEditFileName =
+                "edit_" + day + month + year + hours + minutes + seconds +
+                app_services::ProjectFile::getExtension(format);
             //
             auto saveFile = savedDirectory.getChildFile(loadFileName);
 
@@ -120,7 +132,7 @@ void LoadSaveSongListView::encoder1ButtonReleased() {
 
             tracktion::Engine &engine = *tracktion::Engine::getEngines()[0];
             std::unique_ptr<tracktion::Edit> loadedEdit =
-                tracktion::loadEditFromFile(engine, saveFile);
+                app_services::ProjectFile::loadEdit(engine, saveFile);
 
             /* bool success = loadedEdit->engine.getTemporaryFileManager()
                                .getTempDirectory()
@@ -129,15 +141,8 @@ void LoadSaveSongListView::encoder1ButtonReleased() {
             restartApplication();
 
         } else { // Load
-            juce::String projectName = viewModel.getItemNames()[index];
-            juce::File projectDirectory =
-                juce::File::getSpecialLocation(
-                    juce::File::userApplicationDataDirectory)
-                    .getChildFile(JUCE_APPLICATION_NAME_STRING)
-                    .getChildFile("saved");
-
-            juce::File projectFile =
-                projectDirectory.getChildFile(projectName + ".xml");
+            juce::File projectFile = viewModel.getProjectFile(index);
+            auto projectName = projectFile.getFileNameWithoutExtension();
 
             if (projectFile.existsAsFile()) {
                 juce::Logger::writeToLog("Loading project: " + projectName);
@@ -151,6 +156,52 @@ void LoadSaveSongListView::encoder1ButtonReleased() {
         }
     }
 }
+void LoadSaveSongListView::encoder2ButtonReleased() {
+    if (isShowing()) {
+        if (midiCommandManager.getFocusedComponent() == this) {
+            const auto index = viewModel.itemListState.getSelectedItemIndex();
+            if (index == 0)
+                return;
+
+            // export the selected project as XML, readable by other tools
+            auto projectFile = viewModel.getProjectFile(index);
+            auto exportFile =
+                juce::File::getSpecialLocation(
+                    juce::File::userApplicationDataDirectory)
+                    .getChildFile(JUCE_APPLICATION_NAME_STRING)
+                    .getChildFile("exports")
+                    .getChildFile(projectFile.getFileNameWithoutExtension() +
+                                  app_services::ProjectFile::xmlExtension);
+
+            if (app_services::ProjectFile::exportToXml(projectFile,
+                                                       exportFile)) {
+                juce::Logger::writeToLog("Project exported to: " +
+                                         exportFile.getFullPathName());
+                showMessage("Exported!");
+            } else {
+                juce::Logger::writeToLog("Error exporting project: " +
+                                         projectFile.getFullPathName());
+                showMessage("Export Failed!");
+            }
+        }
+    }
+}
+
+void LoadSaveSongListView::showMessage(const juce::String &message) {
+    messageBox.setMessage(message);
+    auto width = messageBox.getFont().getStringWidth(message) + 50;
+    auto height = getHeight() / 6;
+    messageBox.setBounds((getWidth() - width) / 2, (getHeight() - height) / 2,
+                         width, height);
+    messageBox.setVisible(true);
+
+    juce::Component::SafePointer<MessageBox> safeMessageBox(&messageBox);
+    juce::Timer::callAfterDelay(1000, [safeMessageBox] {
+        if (safeMessageBox != nullptr)
+            safeMessageBox->setVisible(false);
+    });
+}
+
 void LoadSaveSongListView::restartApplication() {
     juce::String appPath =
         juce::File::getSpecialLocation(juce::File::currentExecutableFile)
@@ -211,7 +262,7 @@ void LoadSaveSongListView::loadTrackFromFile(const juce::File &projectFile) {
 
         tracktion::Engine &engine = *tracktion::Engine::getEngines()[0];
         std::unique_ptr<tracktion::Edit> loadedEdit =
-            tracktion::loadEditFromFile(engine, projectFile);
+            app_services::ProjectFile::loadEdit(engine, projectFile);
 
         if (loadedEdit) {
             auto userAppDataDirectory = juce::File::getSpecialLocation(
@@ -21,6 +21,7 @@ class LoadSaveSongListView : public juce::Component,
     void encoder1Increased() override;
     void encoder1Decreased() override;
     void encoder1ButtonReleased() override;
+    void encoder2ButtonReleased() override;
     void restartApplication();
     void selectedIndexChanged(int newIndex) override;
 
@@ -35,5 +36,7 @@ class LoadSaveSongListView : public juce::Component,
     TitledListView titledList;
     EditTabBarView editTabBarView;
     MessageBox messageBox;
+
+    void showMessage(const juce::String &message);
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoadSaveSongListView)
 };
@@ -0,0 +1,104 @@
+#include "AudioClipComponent.h"
+
+AudioClipComponent::AudioClipComponent(tracktion::Clip::Ptr c,
+                                       app_services::TimelineCamera &camera)
+    : ClipComponent(c, camera) {
+    peakCache->addListener(this);
+    clip->state.addListener(this);
+    updatePeaks();
+}
+
+AudioClipComponent::~AudioClipComponent() {
+    clip->state.removeListener(this);
+    peakCache->removeListener(this);
+}
+
+tracktion::AudioClipBase *AudioClipComponent::getAudioClip() {
+    return dynamic_cast<tracktion::AudioClipBase *>(clip.get());
+}
+
+void AudioClipComponent::paint(juce::Graphics &g) {
+    ClipComponent::paint(g);
+
+    auto audioClip = getAudioClip();
+    auto p = getParentComponent();
+    if (peaks == nullptr || audioClip == nullptr || p == nullptr)
+        return;
+
+    // samples of the source file covered by one pixel
+    auto pixelsPerSecond = p->getWidth() / camera.getScope();
+    auto sourceSamplesPerSecond =
+        peaks->sampleRate * audioClip->getSpeedRatio();
+    auto samplesPerPixel = sourceSamplesPerSecond / pixelsPerSecond;
+    // the offset is in edit time, it covers more of the source when the clip
+    // plays faster
+    auto offsetSample =
+        clip->getPosition().getOffset().inSeconds() * sourceSamplesPerSecond;
+
+    // a looping clip goes back to the start of its loop range of the source
+    // each time it reaches its end
+    auto loopRange = audioClip->getLoopRange();
+    auto loopStart = loopRange.getStart().inSeconds() * sourceSamplesPerSecond;
+    auto loopEnd = loopRange.getEnd().inSeconds() * sourceSamplesPerSecond;
+    auto loopLength = loopEnd - loopStart;
+    auto isLooping = audioClip->isLooping() && loopLength > 0.0;
+
+    auto centreY = getHeight() / 2.0f;
+    auto halfHeight = getHeight() / 2.0f;
+    auto clipBounds = g.getClipBounds();
+
+    g.setColour(appLookAndFeel.colour3);
+
+    // only the visible columns, each drawn from the coarsest level which
+    // still has a peak per pixel
+    for (int x = clipBounds.getX(); x < clipBounds.getRight(); ++x) {
+        auto startSample = offsetSample + x * samplesPerPixel;
+        auto endSample = startSample + samplesPerPixel;
+
+        if (isLooping && samplesPerPixel >= loopLength) {
+            // the column covers the whole loop
+            startSample = juce::jmin(startSample, loopStart);
+            endSample = loopEnd;
+        } else if (isLooping && startSample >= loopStart) {
+            startSample =
+                loopStart + std::fmod(startSample - loopStart, loopLength);
+            endSample = juce::jmin(startSample + samplesPerPixel, loopEnd);
+        } else if (startSample >= double(peaks->lengthInSamples)) {
+            break;
+        }
+
+        auto peak = peaks->getPeak(startSample, endSample);
+        auto top = centreY - juce::jlimit(-1.0f, 1.0f, peak.getEnd()) *
+                                 halfHeight;
+        auto bottom = centreY - juce::jlimit(-1.0f, 1.0f, peak.getStart()) *
+                                    halfHeight;
+        g.drawVerticalLine(x, top, juce::jmax(bottom, top + 1.0f));
+    }
+}
+
+void AudioClipComponent::updatePeaks() {
+    auto audioClip = getAudioClip();
+    sourceFile =
+        audioClip != nullptr ? audioClip->getOriginalFile() : juce::File();
+    peaks = sourceFile.existsAsFile() ? peakCache->get(sourceFile) : nullptr;
+}
+
+void AudioClipComponent::peaksReady(const juce::File &file) {
+    if (file != sourceFile)
+        return;
+
+    updatePeaks();
+    repaint();
+}
+
+void AudioClipComponent::valueTreePropertyChanged(
+    juce::ValueTree &tree, const juce::Identifier &property) {
+    if (tree != clip->state)
+        return;
+
+    // the source file, the offset or the speed of the clip
+    if (property == tracktion::IDs::source)
+        updatePeaks();
+
+    repaint();
+}
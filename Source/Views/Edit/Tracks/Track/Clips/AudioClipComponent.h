@@ -0,0 +1,28 @@
+#pragma once
+#include "ClipComponent.h"
+#include <app_services/app_services.h>
+#include <tracktion_engine/tracktion_engine.h>
+class AudioClipComponent : public ClipComponent,
+                           private app_services::PeakCache::Listener,
+                           private juce::ValueTree::Listener {
+  public:
+    AudioClipComponent(tracktion::Clip::Ptr c,
+                       app_services::TimelineCamera &camera);
+    ~AudioClipComponent() override;
+
+    tracktion::AudioClipBase *getAudioClip();
+
+    void paint(juce::Graphics &g) override;
+
+  private:
+    juce::SharedResourcePointer<app_services::PeakCache> peakCache;
+    juce::File sourceFile;
+    // nullptr until the peaks of the source file are computed
+    app_services::PeakCache::Handle peaks;
+
+    void updatePeaks();
+
+    void peaksReady(const juce::File &file) override;
+    void valueTreePropertyChanged(juce::ValueTree &tree,
+                                  const juce::Identifier &property) override;
+};
@@ -2,7 +2,17 @@
 
 MidiClipComponent::MidiClipComponent(tracktion::Clip::Ptr c,
                                      app_services::TimelineCamera &camera)
-    : ClipComponent(c, camera) {}
+    : ClipComponent(c, camera),
+      tempoState(clip->edit.state.getChildWithName(
+          tracktion::IDs::TEMPOSEQUENCE)) {
+    clip->state.addListener(this);
+    tempoState.addListener(this);
+}
+
+MidiClipComponent::~MidiClipComponent() {
+    clip->state.removeListener(this);
+    tempoState.removeListener(this);
+}
 
 tracktion::MidiClip *MidiClipComponent::getMidiClip() {
     return dynamic_cast<tracktion::MidiClip *>(clip.get());
@@ -11,44 +21,96 @@ tracktion::MidiClip *MidiClipComponent::getMidiClip() {
 void MidiClipComponent::paint(juce::Graphics &g) {
     ClipComponent::paint(g);
 
-    if (auto mc = getMidiClip()) {
-        if (mc->hasValidSequence()) {
-            auto &seq = mc->getSequence();
-
-            for (auto n : seq.getNotes()) {
-                auto startBeat = mc->getStartBeat().inBeats() +
-                                 n->getStartBeat().inBeats() -
-                                 mc->getOffsetInBeats().inBeats();
-                auto endBeat = mc->getStartBeat().inBeats() +
-                               n->getEndBeat().inBeats() -
-                               mc->getOffsetInBeats().inBeats();
-
-                auto &tempoSequence = clip->edit.tempoSequence;
-
-                auto startTime = tempoSequence.toTime(
-                    tracktion::BeatPosition::fromBeats(startBeat));
-                auto endTime = tempoSequence.toTime(
-                    tracktion::BeatPosition::fromBeats(endBeat));
-
-                if (auto p = getParentComponent()) {
-                    double noteStartX =
-                        camera.timeToX(startTime.inSeconds(), p->getWidth());
-                    double noteEndX =
-                        camera.timeToX(endTime.inSeconds(), p->getWidth());
-                    double y = (1.0 - double(n->getNoteNumber()) / 127.0) *
-                               getHeight();
-
-                    // startX and End are relative to track component currently
-                    // need to convert to this components coordinate system
-                    noteStartX = noteStartX - getX();
-                    noteEndX = noteEndX - getX();
-
-                    g.setColour(appLookAndFeel.colour3.withAlpha(
-                        n->getVelocity() / 127.0f));
-                    g.drawLine(float(noteStartX), float(y), float(noteEndX),
-                               float(y));
-                }
-            }
-        }
+    auto p = getParentComponent();
+    if (p == nullptr)
+        return;
+
+    if (shouldUpdateNotes)
+        updateNotes();
+
+    auto pixelsPerSecond = p->getWidth() / camera.getScope();
+    if (shouldUpdateNotePaths ||
+        !juce::exactlyEqual(pixelsPerSecond, notePathsPixelsPerSecond) ||
+        getHeight() != notePathsHeight)
+        updateNotePaths(pixelsPerSecond);
+
+    for (const auto &[velocity, path] : notePaths) {
+        g.setColour(appLookAndFeel.colour3.withAlpha(velocity / 127.0f));
+        g.fillPath(path);
+    }
+}
+
+void MidiClipComponent::updateNotes() {
+    shouldUpdateNotes = false;
+    shouldUpdateNotePaths = true;
+    notes.clear();
+
+    auto mc = getMidiClip();
+    if (mc == nullptr || !mc->hasValidSequence())
+        return;
+
+    auto offset = mc->getOffsetInBeats().inBeats();
+    for (auto n : mc->getSequence().getNotes())
+        notes.push_back({n->getStartBeat().inBeats() - offset,
+                         n->getEndBeat().inBeats() - offset,
+                         n->getNoteNumber(), n->getVelocity()});
+}
+
+void MidiClipComponent::updateNotePaths(double pixelsPerSecond) {
+    shouldUpdateNotePaths = false;
+    notePathsPixelsPerSecond = pixelsPerSecond;
+    notePathsHeight = getHeight();
+    notePaths.clear();
+
+    auto mc = getMidiClip();
+    if (mc == nullptr)
+        return;
+
+    auto &tempoSequence = clip->edit.tempoSequence;
+    auto clipStartBeat = mc->getStartBeat().inBeats();
+    auto clipStartTime = clip->getPosition().getStart().inSeconds();
+
+    auto beatToX = [&](double beat) {
+        auto time = tempoSequence.toTime(
+            tracktion::BeatPosition::fromBeats(clipStartBeat + beat));
+        return float((time.inSeconds() - clipStartTime) * pixelsPerSecond);
+    };
+
+    for (const auto &note : notes) {
+        auto y = float((1.0 - double(note.noteNumber) / 127.0) * getHeight());
+        notePaths[note.velocity].addLineSegment(
+            {beatToX(note.startBeat), y, beatToX(note.endBeat), y}, 1.0f);
     }
 }
+
+void MidiClipComponent::valueTreePropertyChanged(
+    juce::ValueTree &tree, const juce::Identifier & /*property*/) {
+    treeChanged(tree);
+}
+
+void MidiClipComponent::valueTreeChildAdded(
+    juce::ValueTree &parentTree, juce::ValueTree & /*childWhichHasBeenAdded*/) {
+    treeChanged(parentTree);
+}
+
+void MidiClipComponent::valueTreeChildRemoved(
+    juce::ValueTree &parentTree, juce::ValueTree & /*childWhichHasBeenRemoved*/,
+    int /*indexFromWhichChildWasRemoved*/) {
+    treeChanged(parentTree);
+}
+
+void MidiClipComponent::valueTreeChildOrderChanged(
+    juce::ValueTree &parentTreeWhoseChildrenHaveMoved, int /*oldIndex*/,
+    int /*newIndex*/) {
+    treeChanged(parentTreeWhoseChildrenHaveMoved);
+}
+
+void MidiClipComponent::treeChanged(const juce::ValueTree &tree) {
+    // a tempo change moves the notes in time, their beats stay the same
+    if (tree == tempoState || tree.isAChildOf(tempoState))
+        shouldUpdateNotePaths = true;
+    else
+        shouldUpdateNotes = true;
+
+    repaint();
+}
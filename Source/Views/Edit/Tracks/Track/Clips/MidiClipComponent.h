@@ -1,12 +1,52 @@
 #pragma once
 #include "ClipComponent.h"
+#include <map>
 #include <tracktion_engine/tracktion_engine.h>
-class MidiClipComponent : public ClipComponent {
+class MidiClipComponent : public ClipComponent,
+                          private juce::ValueTree::Listener {
   public:
     MidiClipComponent(tracktion::Clip::Ptr c,
                       app_services::TimelineCamera &camera);
+    ~MidiClipComponent() override;
 
     tracktion::MidiClip *getMidiClip();
 
     void paint(juce::Graphics &g) override;
+
+  private:
+    // notes of the sequence in beats from the start of the clip, read again
+    // when the clip changes
+    struct Note {
+        double startBeat;
+        double endBeat;
+        int noteNumber;
+        int velocity;
+    };
+    std::vector<Note> notes;
+    bool shouldUpdateNotes = true;
+
+    // notes in pixels from the clip start, one path per velocity. Moving the
+    // camera only moves the component, the paths are built again when the
+    // tempo, the zoom or the height change
+    std::map<int, juce::Path> notePaths;
+    bool shouldUpdateNotePaths = true;
+    double notePathsPixelsPerSecond = 0.0;
+    int notePathsHeight = 0;
+
+    juce::ValueTree tempoState;
+
+    void updateNotes();
+    void updateNotePaths(double pixelsPerSecond);
+
+    void valueTreePropertyChanged(juce::ValueTree &tree,
+                                  const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parentTree,
+                             juce::ValueTree &childWhichHasBeenAdded) override;
+    void valueTreeChildRemoved(juce::ValueTree &parentTree,
+                               juce::ValueTree &childWhichHasBeenRemoved,
+                               int indexFromWhichChildWasRemoved) override;
+    void valueTreeChildOrderChanged(
+        juce::ValueTree &parentTreeWhoseChildrenHaveMoved, int oldIndex,
+        int newIndex) override;
+    void treeChanged(const juce::ValueTree &tree);
 };
@@ -3,7 +3,11 @@
 RecordingClipComponent::RecordingClipComponent(
     tracktion::Track::Ptr t, app_services::TimelineCamera &cam)
     : track(t), camera(cam) {
-    startTimerHz(120);
+    frameScheduler->addClient(this, this);
+}
+
+RecordingClipComponent::~RecordingClipComponent() {
+    frameScheduler->removeClient(this);
 }
 
 void RecordingClipComponent::paint(juce::Graphics &g) {
@@ -12,7 +16,7 @@ void RecordingClipComponent::paint(juce::Graphics &g) {
     g.drawRect(getLocalBounds());
 }
 
-void RecordingClipComponent::timerCallback() { updatePosition(); }
+void RecordingClipComponent::frameCallback() { updatePosition(); }
 void RecordingClipComponent::updatePosition() {
     auto &edit = track->edit;
 
@@ -3,19 +3,22 @@
 #include <app_services/app_services.h>
 #include <tracktion_engine/tracktion_engine.h>
 
-class RecordingClipComponent : public juce::Component, private juce::Timer {
+class RecordingClipComponent : public juce::Component,
+                               private app_services::FrameScheduler::Client {
   public:
     RecordingClipComponent(tracktion::Track::Ptr t,
                            app_services::TimelineCamera &cam);
+    ~RecordingClipComponent() override;
     void paint(juce::Graphics &g) override;
 
   private:
     tracktion::Track::Ptr track;
     app_services::TimelineCamera &camera;
     double punchInTime = -1.0;
+    juce::SharedResourcePointer<app_services::FrameScheduler> frameScheduler;
 
     AppLookAndFeel appLookAndFeel;
 
-    void timerCallback() override;
+    void frameCallback() override;
     void updatePosition();
 };
@@ -1,4 +1,5 @@
 #include "TrackView.h"
+#include "AudioClipComponent.h"
 #include "MidiClipComponent.h"
 
 TrackView::TrackView(tracktion::AudioTrack::Ptr t,
@@ -7,13 +8,18 @@ TrackView::TrackView(tracktion::AudioTrack::Ptr t,
     selectedTrackMarker.setAlwaysOnTop(true);
 
     viewModel.addListener(this);
+    camera.addListener(this);
 
     addChildComponent(selectedTrackMarker);
 
-    startTimerHz(120);
+    frameScheduler->addClient(this, this);
 }
 
-TrackView::~TrackView() { viewModel.removeListener(this); }
+TrackView::~TrackView() {
+    frameScheduler->removeClient(this);
+    camera.removeListener(this);
+    viewModel.removeListener(this);
+}
 
 void TrackView::paint(juce::Graphics &g) {
     g.fillAll(juce::Colour(0x00282828));
@@ -21,6 +27,19 @@ void TrackView::paint(juce::Graphics &g) {
 
 void TrackView::resized() {
     selectedTrackMarker.setBounds(getLocalBounds());
+    layoutClips();
+}
+
+void TrackView::layoutClips() {
+    shouldLayoutClips = false;
+
+    ++layoutPasses;
+    auto now = juce::Time::getMillisecondCounter();
+    if (now - layoutPassesCountStart >= 1000) {
+        layoutPassesPerSecond = layoutPasses;
+        layoutPasses = 0;
+        layoutPassesCountStart = now;
+    }
 
     for (auto clipComponent : clips) {
         auto &clip = clipComponent->getClip();
@@ -44,29 +63,70 @@ void TrackView::clipsChanged(const juce::Array<tracktion::Clip *> & /*clips*/) {
 }
 void TrackView::clipPositionsChanged(
     const juce::Array<tracktion::Clip *> & /*clips*/) {
-    resized();
+    layoutClips();
 }
 
 void TrackView::transportChanged() {
     buildRecordingClip();
-    buildClips();
-    // resized();
+
+    // new recorded clips are added through clipsChanged, the notes overdubbed
+    // into existing ones only need a repaint
+    for (auto clipComponent : clips)
+        clipComponent->repaint();
+}
+
+void TrackView::cameraChanged() {
+    // the camera can move several times before the next frame
+    shouldLayoutClips = true;
+}
+
+int TrackView::getLayoutPassesPerSecond() {
+    // no layout has been done since the last count
+    if (juce::Time::getMillisecondCounter() - layoutPassesCountStart >= 2000)
+        return 0;
+
+    return layoutPassesPerSecond;
 }
 
 void TrackView::buildClips() {
-    clips.clear();
+    // the components of the clips still on the track are kept, the others
+    // are deleted with this map
+    std::map<juce::uint64, std::unique_ptr<ClipComponent>> previousClips;
+    for (auto clipComponent : clips)
+        previousClips[clipComponent->getClip().itemID.getRawID()].reset(
+            clipComponent);
+    clips.clear(false);
 
     if (auto clipTrack = dynamic_cast<tracktion::ClipTrack *>(
             dynamic_cast<tracktion::Track *>(track.get()))) {
         for (auto clip : clipTrack->getClips()) {
-            if (auto midiClip = dynamic_cast<tracktion::MidiClip *>(clip)) {
-                clips.add(new MidiClipComponent(clip, camera));
-                addAndMakeVisible(clips.getLast());
+            // an undone deletion brings the clip back as a new object
+            auto previous = previousClips.find(clip->itemID.getRawID());
+            if (previous != previousClips.end() &&
+                &previous->second->getClip() == clip) {
+                clips.add(previous->second.release());
+                continue;
+            }
+
+            if (auto clipComponent = createClipComponent(clip)) {
+                addAndMakeVisible(*clipComponent);
+                clips.add(clipComponent.release());
             }
         }
     }
 
-    // resized();
+    layoutClips();
+}
+
+std::unique_ptr<ClipComponent>
+TrackView::createClipComponent(tracktion::Clip *clip) {
+    if (dynamic_cast<tracktion::MidiClip *>(clip) != nullptr)
+        return std::make_unique<MidiClipComponent>(clip, camera);
+
+    if (dynamic_cast<tracktion::AudioClipBase *>(clip) != nullptr)
+        return std::make_unique<AudioClipComponent>(clip, camera);
+
+    return nullptr;
 }
 
 void TrackView::buildRecordingClip() {
@@ -83,6 +143,9 @@ void TrackView::buildRecordingClip() {
     }
 
     if (needed) {
+        if (recordingClip != nullptr)
+            return;
+
         recordingClip = std::make_unique<RecordingClipComponent>(track, camera);
         addAndMakeVisible(*recordingClip);
     } else {
@@ -90,4 +153,8 @@ void TrackView::buildRecordingClip() {
     }
 }
 
-void TrackView::timerCallback() { resized(); }
+void TrackView::frameCallback() {
+    // recorded clips grow without notifying their position
+    if (shouldLayoutClips || track->edit.getTransport().isRecording())
+        layoutClips();
+}
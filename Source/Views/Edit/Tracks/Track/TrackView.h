@@ -9,7 +9,8 @@
 
 class TrackView : public juce::Component,
                   public app_view_models::TrackViewModel::Listener,
-                  private juce::Timer {
+                  public app_services::TimelineCamera::Listener,
+                  private app_services::FrameScheduler::Client {
   public:
     TrackView(tracktion::AudioTrack::Ptr t, app_services::TimelineCamera &cam);
     ~TrackView() override;
@@ -23,21 +24,36 @@ class TrackView : public juce::Component,
     void
     clipPositionsChanged(const juce::Array<tracktion::Clip *> &clips) override;
     void transportChanged() override;
+    void cameraChanged() override;
+
+    /**
+     * Clip layouts done by every track view during the last second, for
+     * profiling
+     */
+    static int getLayoutPassesPerSecond();
 
   private:
     tracktion::AudioTrack::Ptr track;
     app_services::TimelineCamera &camera;
     app_view_models::TrackViewModel viewModel;
     bool isSelected = false;
+    bool shouldLayoutClips = false;
 
     juce::OwnedArray<ClipComponent> clips;
     std::unique_ptr<RecordingClipComponent> recordingClip;
 
     SelectedTrackMarker selectedTrackMarker;
     AppLookAndFeel appLookAndFeel;
-    void timerCallback() override;
+    juce::SharedResourcePointer<app_services::FrameScheduler> frameScheduler;
+    void frameCallback() override;
+    void layoutClips();
     void buildClips();
+    std::unique_ptr<ClipComponent> createClipComponent(tracktion::Clip *clip);
     void buildRecordingClip();
 
+    static inline int layoutPasses = 0;
+    static inline int layoutPassesPerSecond = 0;
+    static inline juce::uint32 layoutPassesCountStart = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackView)
 };
@@ -39,7 +39,7 @@ TracksView::TracksView(tracktion::Edit &e,
     viewModel.listViewModel.addListener(this);
     viewModel.listViewModel.itemListState.addListener(this);
 
-    startTimerHz(60);
+    frameScheduler->addClient(this, this);
 }
 
 TracksView::~TracksView() {
@@ -47,7 +47,7 @@ TracksView::~TracksView() {
     viewModel.removeListener(this);
     viewModel.listViewModel.removeListener(this);
     viewModel.listViewModel.itemListState.removeListener(this);
-    stopTimer();
+    frameScheduler->removeClient(this);
 }
 
 void TracksView::paint(juce::Graphics &g) {
@@ -427,7 +427,7 @@ void TracksView::buildBeats() {
     }
 }
 
-void TracksView::timerCallback() {
+void TracksView::frameCallback() {
     informationPanel.setTimecode(edit.getTimecodeFormat().getString(
         edit.tempoSequence, edit.getTransport().getPosition(), false));
     playheadComponent.setBounds(
@@ -459,8 +459,9 @@ void TracksView::undoButtonReleased() {
 
 // CJM
 void TracksView::noteOnPressed(int noteNumber) {
-    juce::Logger::writeToLog("noteOnPressed  noteNumber" +
-                             std::to_string(noteNumber));
+    app_services::AsyncFileLogger::write(
+        app_services::AsyncFileLogger::Level::debug,
+        "noteOnPressed  noteNumber" + std::to_string(noteNumber));
     if (midiCommandManager.isPlusDown) {
         juce::Logger::writeToLog("Ha entrado en el mute");
 
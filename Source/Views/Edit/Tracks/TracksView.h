@@ -16,7 +16,7 @@ class TracksView : public juce::Component,
                    public app_view_models::TracksListViewModel::Listener,
                    public app_view_models::EditItemListViewModel::Listener,
                    public app_view_models::ItemListState::Listener,
-                   private juce::Timer {
+                   private app_services::FrameScheduler::Client {
   public:
     TracksView(tracktion::Edit &e, app_services::MidiCommandManager &mcm);
     ~TracksView() override;
@@ -94,12 +94,13 @@ class TracksView : public juce::Component,
 
     juce::OwnedArray<juce::DrawableRectangle> beats;
     AppLookAndFeel appLookAndFeel;
+    juce::SharedResourcePointer<app_services::FrameScheduler> frameScheduler;
 
     bool shouldUpdateTrackColour = false;
 
     void buildBeats();
 
-    void timerCallback() override;
+    void frameCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TracksView)
 };
@@ -0,0 +1,70 @@
+#include <app_models/app_models.h>
+#include <gtest/gtest.h>
+
+namespace AppModelsTests {
+
+class StepChannelTest : public ::testing::Test {
+  protected:
+    StepChannelTest() : state(app_models::IDs::STEP_CHANNEL) {
+        state.setProperty(app_models::IDs::stepChannelIndex, 0, nullptr);
+        state.setProperty(app_models::IDs::stepPattern, "0000000000000000",
+                          nullptr);
+    }
+
+    juce::ValueTree state;
+};
+
+TEST_F(StepChannelTest, readsExistingPattern) {
+    // note 0 is the last 3 bits: note 0 = 3, note 1 = 5
+    state.setProperty(app_models::IDs::stepPattern, "101011", nullptr);
+    app_models::StepChannel channel(state);
+
+    EXPECT_EQ(channel.getNote(0), 3);
+    EXPECT_EQ(channel.getNote(1), 5);
+    EXPECT_EQ(channel.getNote(2), 0);
+}
+
+TEST_F(StepChannelTest, setNote) {
+    app_models::StepChannel channel(state);
+
+    for (int i = 0; i < 64; i++)
+        channel.setNote(i, i % 8);
+
+    for (int i = 0; i < 64; i++)
+        EXPECT_EQ(channel.getNote(i), i % 8);
+
+    // out of range notes are ignored
+    channel.setNote(64, 7);
+    EXPECT_EQ(channel.getNote(64), 0);
+}
+
+TEST_F(StepChannelTest, flush) {
+    app_models::StepChannel channel(state);
+
+    channel.setNote(1, 5);
+    EXPECT_TRUE(channel.needsFlush());
+    EXPECT_EQ(state[app_models::IDs::stepPattern].toString(),
+              "0000000000000000");
+
+    channel.flush();
+    EXPECT_FALSE(channel.needsFlush());
+    EXPECT_EQ(state[app_models::IDs::stepPattern].toString(), "101000");
+
+    channel.clearNotes();
+    channel.flush();
+    EXPECT_EQ(state[app_models::IDs::stepPattern].toString(), "0");
+}
+
+TEST_F(StepChannelTest, followsExternalPatternChanges) {
+    app_models::StepChannel channel(state);
+
+    // note 21 overlaps the first and second words of the grid
+    juce::BigInteger b;
+    b.setBitRangeAsInt(21 * 3, 3, 7);
+    state.setProperty(app_models::IDs::stepPattern, b.toString(2), nullptr);
+
+    EXPECT_EQ(channel.getNote(21), 7);
+    EXPECT_EQ(channel.getPattern(), b);
+}
+
+} // namespace AppModelsTests
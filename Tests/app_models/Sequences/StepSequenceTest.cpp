@@ -0,0 +1,49 @@
+#include <app_models/app_models.h>
+#include <gtest/gtest.h>
+
+namespace AppModelsTests {
+
+class StepSequenceTest : public ::testing::Test {
+  protected:
+    StepSequenceTest()
+        : state(app_models::IDs::STEP_SEQUENCE), stepSequence(state) {}
+
+    juce::ValueTree state;
+    app_models::StepSequence stepSequence;
+};
+
+TEST_F(StepSequenceTest, getChannel) {
+    EXPECT_EQ(state.getNumChildren(), 24);
+
+    for (int i = 0; i < 24; i++) {
+        ASSERT_NE(stepSequence.getChannel(i), nullptr);
+        EXPECT_EQ(stepSequence.getChannel(i)->getIndex(), i);
+    }
+
+    EXPECT_EQ(stepSequence.getChannel(-1), nullptr);
+    EXPECT_EQ(stepSequence.getChannel(24), nullptr);
+}
+
+TEST_F(StepSequenceTest, getChannelFollowsChanges) {
+    auto firstChannel = stepSequence.getChannel(0);
+    state.removeChild(0, nullptr);
+    EXPECT_EQ(stepSequence.getChannel(0), nullptr);
+
+    // the channel index is read from the state
+    state.getChild(0).setProperty(app_models::IDs::stepChannelIndex, 0,
+                                  nullptr);
+    ASSERT_NE(stepSequence.getChannel(0), nullptr);
+    EXPECT_NE(stepSequence.getChannel(0), firstChannel);
+    EXPECT_EQ(stepSequence.getChannel(1), nullptr);
+}
+
+TEST_F(StepSequenceTest, clear) {
+    stepSequence.setNote(3, 10, 7);
+    EXPECT_EQ(stepSequence.getNote(3, 10), 7);
+
+    stepSequence.clear();
+    EXPECT_EQ(stepSequence.getNote(3, 10), 0);
+    EXPECT_EQ(state.getNumChildren(), 24);
+}
+
+} // namespace AppModelsTests
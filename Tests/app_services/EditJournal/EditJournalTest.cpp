@@ -0,0 +1,108 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+class EditJournalTest : public ::testing::Test {
+  protected:
+    EditJournalTest() : edit(tracktion::Edit::createSingleTrackEdit(engine)) {
+        projectFile.getFile().create();
+
+        for (auto name : {"A", "B", "C"})
+            items.appendChild(juce::ValueTree(itemType).setProperty(
+                                  nameID, name, nullptr),
+                              nullptr);
+
+        // part of the snapshot the journal starts with
+        edit->state.appendChild(items, nullptr);
+        journal = std::make_unique<app_services::EditJournal>(
+            *edit, projectFile.getFile());
+    }
+
+    ~EditJournalTest() override {
+        journal.reset();
+        app_services::EditJournal::getJournalFile(projectFile.getFile())
+            .deleteFile();
+    }
+
+    juce::ValueTree recover() {
+        // writes the remaining changes to the journal
+        journal.reset();
+
+        return app_services::EditJournal::recover(projectFile.getFile())
+            .getChildWithName(items.getType());
+    }
+
+    const juce::Identifier itemType{"ITEM"};
+    const juce::Identifier nameID{"name"};
+    const juce::Identifier valueID{"value"};
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    juce::TemporaryFile projectFile{".lmn"};
+    juce::ValueTree items{"JOURNAL_TEST"};
+    std::unique_ptr<app_services::EditJournal> journal;
+};
+
+TEST_F(EditJournalTest, replaysChanges) {
+    items.getChild(0).setProperty(valueID, 1, nullptr);
+    items.getChild(1).setProperty(valueID, 2, nullptr);
+    items.getChild(1).removeProperty(valueID, nullptr);
+    items.appendChild(juce::ValueTree(itemType).setProperty(nameID, "D",
+                                                            nullptr),
+                      nullptr);
+
+    auto recovered = recover();
+    ASSERT_TRUE(recovered.isValid());
+    EXPECT_TRUE(recovered.isEquivalentTo(items));
+}
+
+TEST_F(EditJournalTest, propertyChangeBeforeInsertingEarlierSibling) {
+    items.getChild(2).setProperty(valueID, 3, nullptr);
+    items.addChild(juce::ValueTree(itemType).setProperty(nameID, "D", nullptr),
+                   0, nullptr);
+    items.getChild(0).setProperty(valueID, 4, nullptr);
+
+    auto recovered = recover();
+    ASSERT_TRUE(recovered.isValid());
+    EXPECT_TRUE(recovered.isEquivalentTo(items));
+    EXPECT_EQ(recovered.getChild(3)[nameID].toString(), "C");
+    EXPECT_EQ(int(recovered.getChild(3)[valueID]), 3);
+}
+
+TEST_F(EditJournalTest, propertyChangeBeforeRemovingEarlierSibling) {
+    items.getChild(2).setProperty(valueID, 3, nullptr);
+    items.removeChild(0, nullptr);
+    items.getChild(0).setProperty(valueID, 4, nullptr);
+
+    auto recovered = recover();
+    ASSERT_TRUE(recovered.isValid());
+    EXPECT_TRUE(recovered.isEquivalentTo(items));
+    EXPECT_EQ(recovered.getChild(0)[nameID].toString(), "B");
+    EXPECT_EQ(int(recovered.getChild(0)[valueID]), 4);
+    EXPECT_EQ(int(recovered.getChild(1)[valueID]), 3);
+}
+
+TEST_F(EditJournalTest, propertyChangeBeforeMovingEarlierSibling) {
+    items.getChild(1).setProperty(valueID, 2, nullptr);
+    items.moveChild(0, 2, nullptr);
+    items.getChild(0).setProperty(valueID, 5, nullptr);
+
+    auto recovered = recover();
+    ASSERT_TRUE(recovered.isValid());
+    EXPECT_TRUE(recovered.isEquivalentTo(items));
+    EXPECT_EQ(recovered.getChild(0)[nameID].toString(), "B");
+    EXPECT_EQ(int(recovered.getChild(0)[valueID]), 5);
+}
+
+TEST_F(EditJournalTest, propertyChangeOnRemovedTree) {
+    items.getChild(2).setProperty(valueID, 3, nullptr);
+    items.removeChild(2, nullptr);
+    items.getChild(1).setProperty(valueID, 2, nullptr);
+
+    auto recovered = recover();
+    ASSERT_TRUE(recovered.isValid());
+    EXPECT_TRUE(recovered.isEquivalentTo(items));
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,177 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+class PeakCacheTest : public ::testing::Test {
+  protected:
+    using Peaks = app_services::PeakCache::Peaks;
+    static constexpr int samplesPerPeak =
+        app_services::PeakCache::baseSamplesPerPeak;
+
+    /**
+     * Peaks of a wav file whose base peak i goes from -i / 100 on the
+     * second channel to i / 100 on the first one
+     */
+    app_services::PeakCache::Handle computePeaks(int numSamples) {
+        juce::AudioBuffer<float> buffer(2, juce::jmax(1, numSamples));
+        buffer.clear();
+
+        for (int i = 0; i < numSamples; ++i) {
+            auto value = float(i / samplesPerPeak) / 100.0f;
+            // a single sample of each peak reaches its extremes
+            auto isExtreme = i % samplesPerPeak == 1;
+            buffer.setSample(0, i, isExtreme ? value : 0.0f);
+            buffer.setSample(1, i, isExtreme ? -value : 0.0f);
+        }
+
+        juce::MemoryBlock data;
+        juce::WavAudioFormat format;
+
+        {
+            std::unique_ptr<juce::AudioFormatWriter> writer(
+                format.createWriterFor(
+                    new juce::MemoryOutputStream(data, false), 44100.0, 2, 32,
+                    {}, 0));
+            if (writer == nullptr)
+                return nullptr;
+
+            writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        }
+
+        std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(
+            new juce::MemoryInputStream(data, false), true));
+        if (reader == nullptr)
+            return nullptr;
+
+        return app_services::PeakCache::computePeaks(*reader,
+                                                     [] { return false; });
+    }
+
+    static Peaks::Level createLevel(int levelSamplesPerPeak, float value,
+                                    size_t numPeaks) {
+        return {levelSamplesPerPeak,
+                std::vector<juce::Range<float>>(numPeaks, {-value, value})};
+    }
+};
+
+TEST_F(PeakCacheTest, computesEveryLevel) {
+    auto peaks = computePeaks(16 * samplesPerPeak);
+    ASSERT_NE(peaks, nullptr);
+
+    EXPECT_EQ(peaks->sampleRate, 44100.0);
+    EXPECT_EQ(peaks->lengthInSamples, 16 * samplesPerPeak);
+
+    // 16, 8, 4, 2 and 1 peaks
+    ASSERT_EQ(peaks->levels.size(), size_t(5));
+    for (size_t i = 0; i < peaks->levels.size(); ++i) {
+        EXPECT_EQ(peaks->levels[i].samplesPerPeak, samplesPerPeak << i);
+        EXPECT_EQ(peaks->levels[i].peaks.size(), size_t(16 >> i));
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+        auto peak = peaks->levels[0].peaks[i];
+        EXPECT_FLOAT_EQ(peak.getStart(), -float(i) / 100.0f);
+        EXPECT_FLOAT_EQ(peak.getEnd(), float(i) / 100.0f);
+    }
+
+    // the union of the peaks it covers
+    auto second = peaks->levels[1].peaks[1];
+    EXPECT_FLOAT_EQ(second.getStart(), -0.03f);
+    EXPECT_FLOAT_EQ(second.getEnd(), 0.03f);
+
+    auto whole = peaks->levels.back().peaks[0];
+    EXPECT_FLOAT_EQ(whole.getStart(), -0.15f);
+    EXPECT_FLOAT_EQ(whole.getEnd(), 0.15f);
+}
+
+TEST_F(PeakCacheTest, keepsThePartialLastPeak) {
+    auto peaks = computePeaks(3 * samplesPerPeak + 10);
+    ASSERT_NE(peaks, nullptr);
+
+    // 4, 2 and 1 peaks
+    ASSERT_EQ(peaks->levels.size(), size_t(3));
+    ASSERT_EQ(peaks->levels[0].peaks.size(), size_t(4));
+    EXPECT_FLOAT_EQ(peaks->levels[0].peaks[3].getEnd(), 0.03f);
+}
+
+TEST_F(PeakCacheTest, emptyFile) {
+    auto peaks = computePeaks(0);
+    ASSERT_NE(peaks, nullptr);
+
+    EXPECT_EQ(peaks->lengthInSamples, 0);
+    ASSERT_EQ(peaks->levels.size(), size_t(1));
+    EXPECT_TRUE(peaks->levels[0].peaks.empty());
+    EXPECT_TRUE(peaks->getPeak(0.0, 1000.0).isEmpty());
+}
+
+TEST_F(PeakCacheTest, stopsWhenAsked) {
+    juce::AudioBuffer<float> buffer(1, samplesPerPeak);
+    buffer.clear();
+
+    juce::MemoryBlock data;
+    juce::WavAudioFormat format;
+
+    {
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+            new juce::MemoryOutputStream(data, false), 44100.0, 1, 16, {}, 0));
+        ASSERT_NE(writer, nullptr);
+        writer->writeFromAudioSampleBuffer(buffer, 0, samplesPerPeak);
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        format.createReaderFor(new juce::MemoryInputStream(data, false), true));
+    ASSERT_NE(reader, nullptr);
+
+    EXPECT_EQ(
+        app_services::PeakCache::computePeaks(*reader, [] { return true; }),
+        nullptr);
+}
+
+TEST_F(PeakCacheTest, readsTheCoarsestLevelWithAPeakPerRange) {
+    // each level has its own value to tell which one is read
+    Peaks peaks;
+    peaks.lengthInSamples = 4 * samplesPerPeak;
+    peaks.levels.push_back(createLevel(samplesPerPeak, 0.1f, 4));
+    peaks.levels.push_back(createLevel(2 * samplesPerPeak, 0.2f, 2));
+    peaks.levels.push_back(createLevel(4 * samplesPerPeak, 0.4f, 1));
+
+    // smaller than a base peak
+    EXPECT_FLOAT_EQ(peaks.getPeak(0.0, 10.0).getEnd(), 0.1f);
+    EXPECT_FLOAT_EQ(peaks.getPeak(0.0, samplesPerPeak).getEnd(), 0.1f);
+    EXPECT_FLOAT_EQ(peaks.getPeak(0.0, 3 * samplesPerPeak).getEnd(), 0.2f);
+    EXPECT_FLOAT_EQ(peaks.getPeak(0.0, 4 * samplesPerPeak).getEnd(), 0.4f);
+    // coarser than every level
+    EXPECT_FLOAT_EQ(peaks.getPeak(0.0, 100 * samplesPerPeak).getEnd(), 0.4f);
+}
+
+TEST_F(PeakCacheTest, clampsRangesAtTheEdges) {
+    auto peaks = computePeaks(4 * samplesPerPeak);
+    ASSERT_NE(peaks, nullptr);
+
+    // before the start
+    auto first = peaks->getPeak(-100.0, 10.0);
+    EXPECT_FLOAT_EQ(first.getStart(), 0.0f);
+    EXPECT_FLOAT_EQ(first.getEnd(), 0.0f);
+
+    // across the end, the last peak
+    auto last = peaks->getPeak(3.5 * samplesPerPeak, 4.5 * samplesPerPeak);
+    EXPECT_FLOAT_EQ(last.getStart(), -0.03f);
+    EXPECT_FLOAT_EQ(last.getEnd(), 0.03f);
+
+    // past the end
+    EXPECT_TRUE(peaks->getPeak(5.0 * samplesPerPeak, 6.0 * samplesPerPeak)
+                    .isEmpty());
+}
+
+TEST_F(PeakCacheTest, includesEveryPeakOfTheRange) {
+    auto peaks = computePeaks(8 * samplesPerPeak);
+    ASSERT_NE(peaks, nullptr);
+
+    // from the middle of the second base peak to the middle of the third
+    auto peak = peaks->getPeak(1.5 * samplesPerPeak, 2.5 * samplesPerPeak);
+    EXPECT_FLOAT_EQ(peak.getStart(), -0.02f);
+    EXPECT_FLOAT_EQ(peak.getEnd(), 0.02f);
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,131 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+class TaskGraphTest : public ::testing::Test {
+  protected:
+    using RunOn = app_services::TaskGraph::RunOn;
+
+    std::function<void()> record(const juce::String &name) {
+        return [this, name] {
+            const juce::ScopedLock sl(lock);
+            ran.add(name);
+        };
+    }
+
+    app_services::TaskGraph graph{"Test"};
+    juce::CriticalSection lock;
+    juce::StringArray ran;
+};
+
+TEST_F(TaskGraphTest, runsTasksAfterTheirDependencies) {
+    graph.add("c", record("c"), {"b"}, RunOn::background);
+    graph.add("a", record("a"));
+    graph.add("b", record("b"), {"a"});
+    graph.add("d", record("d"), {"a", "c"});
+
+    ASSERT_TRUE(graph.run());
+    EXPECT_EQ(ran, juce::StringArray({"a", "b", "c", "d"}));
+}
+
+TEST_F(TaskGraphTest, runsIndependentTasks) {
+    graph.add("a", record("a"));
+    graph.add("b", record("b"), {}, RunOn::background);
+    graph.add("c", record("c"), {}, RunOn::background);
+
+    ASSERT_TRUE(graph.run());
+    EXPECT_EQ(ran.size(), 3);
+    EXPECT_TRUE(ran.contains("a"));
+    EXPECT_TRUE(ran.contains("b"));
+    EXPECT_TRUE(ran.contains("c"));
+}
+
+TEST_F(TaskGraphTest, rejectsCircularDependencies) {
+    graph.add("a", record("a"), {"c"});
+    graph.add("b", record("b"), {"a"}, RunOn::background);
+    graph.add("c", record("c"), {"b"});
+    graph.add("d", record("d"));
+
+    EXPECT_FALSE(graph.run());
+    EXPECT_TRUE(ran.isEmpty());
+}
+
+TEST_F(TaskGraphTest, rejectsUnknownDependencies) {
+    graph.add("a", record("a"));
+    graph.add("b", record("b"), {"a", "missing"});
+
+    EXPECT_FALSE(graph.run());
+    EXPECT_TRUE(ran.isEmpty());
+}
+
+TEST_F(TaskGraphTest, rejectsDuplicateNames) {
+    graph.add("a", record("a"));
+    graph.add("a", record("a"), {}, RunOn::background);
+
+    EXPECT_FALSE(graph.run());
+    EXPECT_TRUE(ran.isEmpty());
+}
+
+TEST_F(TaskGraphTest, runsCallerTasksOnTheCallingThread) {
+    auto callingThread = juce::Thread::getCurrentThreadId();
+    juce::Thread::ThreadID callerTaskThread = nullptr;
+    juce::Thread::ThreadID backgroundTaskThread = nullptr;
+
+    graph.add("caller", [&] {
+        callerTaskThread = juce::Thread::getCurrentThreadId();
+    });
+    graph.add(
+        "background",
+        [&] { backgroundTaskThread = juce::Thread::getCurrentThreadId(); },
+        {"caller"}, RunOn::background);
+
+    ASSERT_TRUE(graph.run());
+    EXPECT_EQ(callerTaskThread, callingThread);
+    EXPECT_NE(backgroundTaskThread, nullptr);
+    EXPECT_NE(backgroundTaskThread, callingThread);
+}
+
+TEST_F(TaskGraphTest, runsBackgroundTasksInParallel) {
+    if (juce::SystemStats::getNumCpus() < 2)
+        GTEST_SKIP() << "a single thread runs the background tasks";
+
+    // each task only finishes once the other one has started
+    juce::WaitableEvent aStarted, bStarted;
+    bool aSawB = false, bSawA = false;
+
+    graph.add(
+        "a",
+        [&] {
+            aStarted.signal();
+            aSawB = bStarted.wait(5000);
+        },
+        {}, RunOn::background);
+    graph.add(
+        "b",
+        [&] {
+            bStarted.signal();
+            bSawA = aStarted.wait(5000);
+        },
+        {}, RunOn::background);
+
+    ASSERT_TRUE(graph.run());
+    EXPECT_TRUE(aSawB);
+    EXPECT_TRUE(bSawA);
+}
+
+TEST_F(TaskGraphTest, recordsTimings) {
+    graph.add("a", [] { juce::Thread::sleep(20); });
+    graph.add("b", [] {}, {"a"}, RunOn::background);
+
+    ASSERT_TRUE(graph.run());
+
+    auto timings = graph.getTimings();
+    ASSERT_EQ(timings.size(), size_t(2));
+    EXPECT_EQ(timings[0].name, "a");
+    EXPECT_EQ(timings[1].name, "b");
+    EXPECT_GE(timings[0].durationMs, 15.0);
+    EXPECT_GE(timings[1].startMs, timings[0].startMs + timings[0].durationMs);
+}
+
+} // namespace AppServicesTests
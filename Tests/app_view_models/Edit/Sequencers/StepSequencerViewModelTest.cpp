@@ -18,6 +18,12 @@ class StepSequencerViewModelTest : public ::testing::Test {
     // EDIT_VIEW_STATE is used in the step seq VM
     app_view_models::EditViewModel editViewModel;
     app_view_models::StepSequencerViewModel viewModel;
+
+    tracktion::MidiList &getSequence() {
+        auto clip = dynamic_cast<tracktion::MidiClip *>(
+            tracktion::getAudioTracks(*edit)[0]->getClips().getFirst());
+        return clip->getSequence();
+    }
 };
 
 TEST_F(StepSequencerViewModelTest, getNumChannels) {
@@ -28,4 +34,74 @@ TEST_F(StepSequencerViewModelTest, getNumNotesPerChannel) {
     EXPECT_EQ(viewModel.getNumNotesPerChannel(), 64);
 }
 
+TEST_F(StepSequencerViewModelTest, toggleNoteNumberAtSelectedIndex) {
+    // note number 53 is the first channel in the default octave
+    EXPECT_EQ(viewModel.noteNumberToChannel(53), 0);
+    EXPECT_EQ(viewModel.noteIntensityAt(0, 0), 0);
+
+    viewModel.toggleNoteNumberAtSelectedIndex(53);
+    EXPECT_EQ(viewModel.noteIntensityAt(0, 0), 3);
+    viewModel.toggleNoteNumberAtSelectedIndex(53);
+    EXPECT_EQ(viewModel.noteIntensityAt(0, 0), 5);
+    viewModel.toggleNoteNumberAtSelectedIndex(53);
+    EXPECT_EQ(viewModel.noteIntensityAt(0, 0), 7);
+    viewModel.toggleNoteNumberAtSelectedIndex(53);
+    EXPECT_EQ(viewModel.noteIntensityAt(0, 0), 0);
+
+    EXPECT_EQ(viewModel.noteIntensityAt(1, 0), 0);
+}
+
+TEST_F(StepSequencerViewModelTest, syncMidiSequence) {
+    auto &sequence = getSequence();
+    EXPECT_TRUE(sequence.isEmpty());
+
+    // changes are written to the clip on sync only
+    viewModel.toggleNoteNumberAtSelectedIndex(53);
+    EXPECT_TRUE(sequence.isEmpty());
+
+    viewModel.syncMidiSequence();
+    ASSERT_EQ(sequence.getNumNotes(), 1);
+    EXPECT_EQ(sequence.getNotes()[0]->getNoteNumber(), 53);
+    EXPECT_EQ(sequence.getNotes()[0]->getStartBeat().inBeats(), 0.0);
+    EXPECT_EQ(sequence.getNotes()[0]->getVelocity(), 3 * 18);
+
+    // the same note is updated
+    viewModel.toggleNoteNumberAtSelectedIndex(53);
+    viewModel.syncMidiSequence();
+    ASSERT_EQ(sequence.getNumNotes(), 1);
+    EXPECT_EQ(sequence.getNotes()[0]->getVelocity(), 5 * 18);
+
+    viewModel.clearNotesAtSelectedIndex();
+    EXPECT_TRUE(sequence.isEmpty());
+}
+
+TEST_F(StepSequencerViewModelTest, syncMidiSequenceRemovesUnknownNotes) {
+    auto &sequence = getSequence();
+
+    // a note between two steps can't be displayed by the step sequencer
+    sequence.addNote(53, tracktion::BeatPosition::fromBeats(0.1),
+                     tracktion::BeatDuration::fromBeats(0.25), 127, 1, nullptr);
+    viewModel.toggleNoteNumberAtSelectedIndex(54);
+    viewModel.syncMidiSequence();
+
+    ASSERT_EQ(sequence.getNumNotes(), 1);
+    EXPECT_EQ(sequence.getNotes()[0]->getNoteNumber(), 54);
+}
+
+TEST_F(StepSequencerViewModelTest, beginAndCommitEdit) {
+    auto &sequence = getSequence();
+    viewModel.toggleNoteNumberAtSelectedIndex(53);
+    viewModel.syncMidiSequence();
+    ASSERT_EQ(sequence.getNumNotes(), 1);
+
+    // the clip is synced by the outermost commit only
+    viewModel.beginEdit();
+    viewModel.clearNotesAtSelectedIndex();
+    EXPECT_EQ(viewModel.noteIntensityAt(0, 0), 0);
+    EXPECT_EQ(sequence.getNumNotes(), 1);
+
+    viewModel.commitEdit();
+    EXPECT_TRUE(sequence.isEmpty());
+}
+
 } // namespace AppViewModelsTests
\ No newline at end of file